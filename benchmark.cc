@@ -1,20 +1,26 @@
 #include "benchmark.h"
 
+#include <glob.h>
+
 #include <cstdlib>
+#include <sstream>
 
 #include "benchmarks/benchmark_alex.h"
 #include "benchmarks/benchmark_lipp.h"
 #include "benchmarks/benchmark_art.h"
 #include "benchmarks/benchmark_artolc.h"
 #include "benchmarks/benchmark_btree.h"
+#include "benchmarks/benchmark_cached.h"
 #include "benchmarks/benchmark_xindex.h"
 #include "benchmarks/benchmark_finedex.h"
 #include "benchmarks/benchmark_sindex.h"
 #include "benchmarks/benchmark_fast.h"
+#include "benchmarks/benchmark_filtered.h"
 #include "benchmarks/benchmark_mabtree.h"
 #include "benchmarks/benchmark_pgm.h"
 #include "benchmarks/benchmark_dynamic_pgm.h"
 #include "benchmarks/benchmark_rmi.h"
+#include "benchmarks/benchmark_rmi_native.h"
 #include "benchmarks/benchmark_ts.h"
 #include "benchmarks/benchmark_wormhole.h"
 #include "searches/linear_search.h"
@@ -29,23 +35,37 @@ using namespace std;
 #define COMMA ,
 
 #define check_only(tag, code)                                                                             \
-  if (!only_mode || (only == (tag))) {                                                                    \
+  if (!only_mode || only_matches(only, (tag))) {                                                          \
     code;                                                                                                 \
   }
 #define add_search_type(name, func, type, search_class, record)                                           \
   if (search_type == (name) ) {                                                                           \
-    tli::Benchmark<type> benchmark(                                                                      \
-        filename, ops, num_repeats, through, build, fence, cold_cache,                                    \
-        track_errors, csv, num_threads, verify);                                                          \
-    func<search_class, record>(benchmark, pareto, params, only_mode, only, filename);                     \
+    tli::Benchmark<type> benchmark(                                                                       \
+        filename, ops_files[0], num_repeats, through, build, fence, cold_cache,                           \
+        track_errors, csv, num_threads, build_threads, verify, huge_pages,                                \
+        batch_size, percentiles, perf);                                                                   \
+    if (!snapshot_dir.empty()) benchmark.SetSnapshotDir(snapshot_dir);                                    \
+    if (fork_repeats) benchmark.EnableForkRepeats();                                                      \
+    for (size_t ops_i = 0; ops_i < ops_files.size(); ++ops_i) {                                           \
+      if (ops_i > 0) benchmark.LoadWorkload(ops_files[ops_i]);                                            \
+      if (tune) benchmark.EnableTuning(tune_ops, tune_budget);                                            \
+      func<search_class, record>(benchmark, pareto, params, only_mode, only, filename);                   \
+      benchmark.Tune();                                                                                   \
+    }                                                                                                     \
     break;                                                                                                \
   }
 #define add_default(func, type, record)                                                                   \
   if (!pareto && params.empty()) {                                                                        \
-    tli::Benchmark<type> benchmark(                                                                      \
-        filename, ops, num_repeats, through, build, fence, cold_cache,                                    \
-        track_errors, csv, num_threads, verify);                                                          \
-    func<record>(benchmark, only_mode, only, ops);                                                        \
+    tli::Benchmark<type> benchmark(                                                                       \
+        filename, ops_files[0], num_repeats, through, build, fence, cold_cache,                           \
+        track_errors, csv, num_threads, build_threads, verify, huge_pages,                                \
+        batch_size, percentiles, perf);                                                                   \
+    if (!snapshot_dir.empty()) benchmark.SetSnapshotDir(snapshot_dir);                                    \
+    if (fork_repeats) benchmark.EnableForkRepeats();                                                      \
+    for (size_t ops_i = 0; ops_i < ops_files.size(); ++ops_i) {                                           \
+      if (ops_i > 0) benchmark.LoadWorkload(ops_files[ops_i]);                                            \
+      func<record>(benchmark, only_mode, only, ops_files[ops_i]);                                         \
+    }                                                                                                     \
     break;                                                                                                \
   }
 #define add_search_types(func, type, record)                                                              \
@@ -56,12 +76,44 @@ using namespace std;
   add_search_type("interpolation", func, type, InterpolationSearch<record>, record);                      \
   add_search_type("exponential", func, type, ExponentialSearch<record>, record);
 
+// Whether index `tag` is one of the comma-separated indexes of `only`.
+static bool only_matches(const std::string& only, const std::string& tag) {
+  std::stringstream ss(only);
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    if (item == tag) return true;
+  }
+  return false;
+}
+
+// Workload files matching any of `patterns`, each a file name or a glob
+// pattern, in order of the patterns and sorted within a pattern.
+static std::vector<std::string> expand_workloads(const std::vector<std::string>& patterns) {
+  std::vector<std::string> files;
+  for (const auto& pattern : patterns) {
+    glob_t matches;
+    if (glob(pattern.c_str(), 0, nullptr, &matches) != 0) {
+      util::fail("no workload matches " + pattern);
+    }
+    for (size_t i = 0; i < matches.gl_pathc; ++i) {
+      const std::string file = matches.gl_pathv[i];
+      // Bulk-loaded data is read along with its workload.
+      if (file.size() < 9 || file.compare(file.size() - 9, 9, "_bulkload") != 0) {
+        files.push_back(file);
+      }
+    }
+    globfree(&matches);
+  }
+  return files;
+}
+
 template <class SearchClass, int record>
 void execute_64_bit(tli::Benchmark<uint64_t>& benchmark, bool pareto, const std::vector<int>& params, bool only_mode,
                     const std::string& only, const std::string& filename) {
   // Build and probe individual indexes.
   if constexpr (record != 2){
     check_only("RMI", benchmark_64_rmi<SearchClass>(benchmark, pareto, params, filename));
+    check_only("RMINative", benchmark_64_rmi_native<SearchClass>(benchmark, pareto, params));
     check_only("TS", benchmark_64_ts<SearchClass>(benchmark, pareto, params));
     check_only("PGM", benchmark_64_pgm<SearchClass>(benchmark, pareto, params));
     check_only("DynamicPGM", benchmark_64_dynamic_pgm<SearchClass>(benchmark, pareto, params));
@@ -71,6 +123,17 @@ void execute_64_bit(tli::Benchmark<uint64_t>& benchmark, bool pareto, const std:
     check_only("ALEX", benchmark_64_alex<SearchClass>(benchmark, pareto, params));
     check_only("LIPP", benchmark_64_lipp(benchmark));
     check_only("MABTree", benchmark_64_mabtree<SearchClass>(benchmark, pareto, params));
+    // Filtered and cached indexes only run when asked for by name.
+    if (only_mode){
+      check_only("FilteredPGM", benchmark_64_filtered<SearchClass>(benchmark, pareto, params, "PGM"));
+      check_only("FilteredBTree", benchmark_64_filtered<SearchClass>(benchmark, pareto, params, "BTree"));
+      check_only("FilteredALEX", benchmark_64_filtered<SearchClass>(benchmark, pareto, params, "ALEX"));
+      check_only("FilteredART", benchmark_64_filtered<SearchClass>(benchmark, pareto, params, "ART"));
+      check_only("CachedPGM", benchmark_64_cached<SearchClass>(benchmark, pareto, params, "PGM"));
+      check_only("CachedBTree", benchmark_64_cached<SearchClass>(benchmark, pareto, params, "BTree"));
+      check_only("CachedALEX", benchmark_64_cached<SearchClass>(benchmark, pareto, params, "ALEX"));
+      check_only("CachedART", benchmark_64_cached<SearchClass>(benchmark, pareto, params, "ART"));
+    }
   }
   check_only("ARTOLC", benchmark_64_artolc(benchmark));
   check_only("FINEdex", benchmark_64_finedex<SearchClass>(benchmark, pareto, params, filename));
@@ -86,6 +149,7 @@ void execute_64_bit(tli::Benchmark<uint64_t>& benchmark, bool only_mode,
   // Build and probe individual indexes.
   if constexpr (record != 2){
     check_only("RMI", benchmark_64_rmi<record>(benchmark, filename));
+    check_only("RMINative", benchmark_64_rmi_native<record>(benchmark, filename));
     check_only("TS", benchmark_64_ts<record>(benchmark, filename));
     check_only("PGM", benchmark_64_pgm<record>(benchmark, filename));
     check_only("DynamicPGM", benchmark_64_dynamic_pgm<record>(benchmark, filename));
@@ -95,6 +159,17 @@ void execute_64_bit(tli::Benchmark<uint64_t>& benchmark, bool only_mode,
     check_only("ALEX", benchmark_64_alex<record>(benchmark, filename));
     check_only("LIPP", benchmark_64_lipp(benchmark));
     check_only("MABTree", benchmark_64_mabtree<record>(benchmark, filename));
+    // Filtered and cached indexes only run when asked for by name.
+    if (only_mode){
+      check_only("FilteredPGM", benchmark_64_filtered<record>(benchmark, "PGM"));
+      check_only("FilteredBTree", benchmark_64_filtered<record>(benchmark, "BTree"));
+      check_only("FilteredALEX", benchmark_64_filtered<record>(benchmark, "ALEX"));
+      check_only("FilteredART", benchmark_64_filtered<record>(benchmark, "ART"));
+      check_only("CachedPGM", benchmark_64_cached<record>(benchmark, "PGM"));
+      check_only("CachedBTree", benchmark_64_cached<record>(benchmark, "BTree"));
+      check_only("CachedALEX", benchmark_64_cached<record>(benchmark, "ALEX"));
+      check_only("CachedART", benchmark_64_cached<record>(benchmark, "ART"));
+    }
   }
   check_only("ARTOLC", benchmark_64_artolc(benchmark));
   check_only("FINEdex", benchmark_64_finedex<record>(benchmark, filename));
@@ -104,6 +179,78 @@ void execute_64_bit(tli::Benchmark<uint64_t>& benchmark, bool only_mode,
   #endif
 }
 
+template <class SearchClass, int record>
+void execute_32_bit(tli::Benchmark<uint32_t>& benchmark, bool pareto, const std::vector<int>& params, bool only_mode,
+                    const std::string& only, const std::string& filename) {
+  // Build and probe individual indexes.
+  if constexpr (record != 2){
+    check_only("RMI", benchmark_32_rmi<SearchClass>(benchmark, pareto, params, filename));
+    check_only("RMINative", benchmark_32_rmi_native<SearchClass>(benchmark, pareto, params));
+    check_only("TS", benchmark_32_ts<SearchClass>(benchmark, pareto, params));
+    check_only("PGM", benchmark_32_pgm<SearchClass>(benchmark, pareto, params));
+    check_only("DynamicPGM", benchmark_32_dynamic_pgm<SearchClass>(benchmark, pareto, params));
+    check_only("ART", benchmark_32_art(benchmark));
+    check_only("BTree", benchmark_32_btree<SearchClass>(benchmark, pareto, params));
+    check_only("FAST", benchmark_32_fast(benchmark));
+    check_only("ALEX", benchmark_32_alex<SearchClass>(benchmark, pareto, params));
+    check_only("LIPP", benchmark_32_lipp(benchmark));
+    check_only("MABTree", benchmark_32_mabtree<SearchClass>(benchmark, pareto, params));
+    // Filtered and cached indexes only run when asked for by name.
+    if (only_mode){
+      check_only("FilteredPGM", benchmark_32_filtered<SearchClass>(benchmark, pareto, params, "PGM"));
+      check_only("FilteredBTree", benchmark_32_filtered<SearchClass>(benchmark, pareto, params, "BTree"));
+      check_only("FilteredALEX", benchmark_32_filtered<SearchClass>(benchmark, pareto, params, "ALEX"));
+      check_only("FilteredART", benchmark_32_filtered<SearchClass>(benchmark, pareto, params, "ART"));
+      check_only("CachedPGM", benchmark_32_cached<SearchClass>(benchmark, pareto, params, "PGM"));
+      check_only("CachedBTree", benchmark_32_cached<SearchClass>(benchmark, pareto, params, "BTree"));
+      check_only("CachedALEX", benchmark_32_cached<SearchClass>(benchmark, pareto, params, "ALEX"));
+      check_only("CachedART", benchmark_32_cached<SearchClass>(benchmark, pareto, params, "ART"));
+    }
+  }
+  check_only("ARTOLC", benchmark_32_artolc(benchmark));
+  check_only("FINEdex", benchmark_32_finedex<SearchClass>(benchmark, pareto, params, filename));
+  check_only("XIndex", benchmark_32_xindex<SearchClass>(benchmark, pareto, params, filename));
+  #ifndef __APPLE__
+    check_only("Wormhole",benchmark_32_wormhole(benchmark));
+  #endif
+}
+
+template <int record>
+void execute_32_bit(tli::Benchmark<uint32_t>& benchmark, bool only_mode,
+                    const std::string& only, const std::string& filename) {
+  // Build and probe individual indexes.
+  if constexpr (record != 2){
+    check_only("RMI", benchmark_32_rmi<record>(benchmark, filename));
+    check_only("RMINative", benchmark_32_rmi_native<record>(benchmark, filename));
+    check_only("TS", benchmark_32_ts<record>(benchmark, filename));
+    check_only("PGM", benchmark_32_pgm<record>(benchmark, filename));
+    check_only("DynamicPGM", benchmark_32_dynamic_pgm<record>(benchmark, filename));
+    check_only("ART", benchmark_32_art(benchmark));
+    check_only("BTree", benchmark_32_btree<record>(benchmark, filename));
+    check_only("FAST", benchmark_32_fast(benchmark));
+    check_only("ALEX", benchmark_32_alex<record>(benchmark, filename));
+    check_only("LIPP", benchmark_32_lipp(benchmark));
+    check_only("MABTree", benchmark_32_mabtree<record>(benchmark, filename));
+    // Filtered and cached indexes only run when asked for by name.
+    if (only_mode){
+      check_only("FilteredPGM", benchmark_32_filtered<record>(benchmark, "PGM"));
+      check_only("FilteredBTree", benchmark_32_filtered<record>(benchmark, "BTree"));
+      check_only("FilteredALEX", benchmark_32_filtered<record>(benchmark, "ALEX"));
+      check_only("FilteredART", benchmark_32_filtered<record>(benchmark, "ART"));
+      check_only("CachedPGM", benchmark_32_cached<record>(benchmark, "PGM"));
+      check_only("CachedBTree", benchmark_32_cached<record>(benchmark, "BTree"));
+      check_only("CachedALEX", benchmark_32_cached<record>(benchmark, "ALEX"));
+      check_only("CachedART", benchmark_32_cached<record>(benchmark, "ART"));
+    }
+  }
+  check_only("ARTOLC", benchmark_32_artolc(benchmark));
+  check_only("FINEdex", benchmark_32_finedex<record>(benchmark, filename));
+  check_only("XIndex", benchmark_32_xindex<record>(benchmark, filename));
+  #ifndef __APPLE__
+    check_only("Wormhole",benchmark_32_wormhole(benchmark));
+  #endif
+}
+
 template <class SearchClass, int record>
 void execute_string(tli::Benchmark<std::string>& benchmark, bool pareto, const std::vector<int>& params, bool only_mode,
                     const std::string& only, const std::string& filename) {
@@ -141,11 +288,13 @@ int main(int argc, char* argv[]) {
       "help", "Displays help")(
       "t,threads", "Number of lookup threads",
       cxxopts::value<int>()->default_value("1"))(
+      "build-threads", "Number of threads for bulk loading, at least the lookup threads",
+      cxxopts::value<int>()->default_value("1"))(
       "through", "Measure throughput")(
       "r,repeats", "Number of repeats",
       cxxopts::value<int>()->default_value("1"))(
       "b,build", "Only measure and report build times")(
-      "only", "Only run the specified index",
+      "only", "Only run the specified indexes, comma-separated",
       cxxopts::value<std::string>()->default_value(""))(
       "cold-cache", "Clear the CPU cache between each lookup")(
       "pareto", "Run with multiple different sizes for each competitor")(
@@ -153,10 +302,26 @@ int main(int argc, char* argv[]) {
       "errors", "Tracks index errors, and report those instead of lookup times")(
       "verify", "Verify the correctness of execution")(
       "csv", "Output a CSV of results in addition to a text file")(
+      "huge-pages", "Advise transparent huge pages for the mapped data and workload")(
+      "batch", "Issue consecutive lookups in batches of this size",
+      cxxopts::value<int>()->default_value("1"))(
+      "perf", "Report hardware counters per operation, measured around the operations only")(
+      "percentiles", "Latency percentiles to report",
+      cxxopts::value<std::vector<double>>()->default_value("50,99,99.9"))(
       "search", "Specify a search type, one of: linear, avx, binary, interpolation, exponential",
       cxxopts::value<std::string>()->default_value("binary"))(
       "params", "Set the parameters of index",
-      cxxopts::value<std::vector<int>>()->default_value(""));
+      cxxopts::value<std::vector<int>>()->default_value(""))(
+      "tune", "Race the --pareto variants on growing workload samples and report the Pareto frontier of throughput and size")(
+      "tune-ops", "Operations per thread of the first tuning round",
+      cxxopts::value<int>()->default_value("100000"))(
+      "tune-budget", "Drop tuning candidates larger than this many MiB, 0 for no budget",
+      cxxopts::value<int>()->default_value("0"))(
+      "suite", "Run every workload matching these comma-separated files or glob patterns instead of <ops>, loading the data once",
+      cxxopts::value<std::vector<std::string>>())(
+      "fork", "Run every repeat in a process forked from one build, instead of rebuilding the index")(
+      "snapshot-dir", "Reload indexes from snapshots cached in this directory, saving them on first build",
+      cxxopts::value<std::string>()->default_value(""));
 
   options.parse_positional({"data", "ops"});
 
@@ -167,7 +332,7 @@ int main(int argc, char* argv[]) {
     exit(0);
   }
 
-  const bool through = result.count("through");
+  const bool through = result.count("through") || result.count("tune");
 
   const size_t num_repeats = through ? result["repeats"].as<int>() : 1;
   cout << "Repeating lookup code " << num_repeats << " time(s)." << endl;
@@ -175,16 +340,49 @@ int main(int argc, char* argv[]) {
   const size_t num_threads = result["threads"].as<int>();
   cout << "Using " << num_threads << " thread(s)." << endl;
 
+  const size_t build_threads = std::max<size_t>(result["build-threads"].as<int>(), num_threads);
+  if (build_threads > num_threads) {
+    cout << "Bulk loading with " << build_threads << " thread(s)." << endl;
+  }
+
+  const size_t batch_size = result["batch"].as<int>();
+  if (batch_size > 1) {
+    cout << "Batching up to " << batch_size << " lookup(s)." << endl;
+  }
+
+  const bool perf = result.count("perf");
+  if (perf) {
+    cout << "Reporting per operation:";
+    for (const auto& name : tli::perf_counter_names) cout << " " << name;
+    cout << endl;
+  }
+
   const bool build = result.count("build");
   const bool fence = result.count("fence");
   const bool track_errors = result.count("errors");
   const bool verify = result.count("verify");
   const bool cold_cache = result.count("cold-cache");
   const bool csv = result.count("csv");
-  const bool pareto = result.count("pareto");
+  const bool huge_pages = result.count("huge-pages");
+  const std::vector<double> percentiles = result["percentiles"].as<std::vector<double>>();
+  const bool tune = result.count("tune");
+  const size_t tune_ops = result["tune-ops"].as<int>();
+  const size_t tune_budget = size_t(result["tune-budget"].as<int>()) << 20;
+  const bool pareto = result.count("pareto") || tune;
   const std::string filename = result["data"].as<std::string>();
-  const std::string ops = result["ops"].as<std::string>();
+  std::vector<std::string> ops_files;
+  if (result.count("suite")) {
+    ops_files = expand_workloads(result["suite"].as<std::vector<std::string>>());
+    cout << "Running a suite of " << ops_files.size() << " workload(s)." << endl;
+  } else {
+    ops_files.push_back(result["ops"].as<std::string>());
+  }
+  if (ops_files.empty()) {
+    util::fail("No workload to run.");
+  }
   const std::string search_type = result["search"].as<std::string>();
+  const std::string snapshot_dir = result["snapshot-dir"].as<std::string>();
+  const bool fork_repeats = result.count("fork");
   const bool only_mode = result.count("only") || std::getenv("TLI_ONLY");
   const std::vector<int> params = result["params"].as<std::vector<int>>();
   std::string only;
@@ -220,6 +418,21 @@ int main(int argc, char* argv[]) {
       break;
     }
 
+    case DataType::UINT32: {
+      // Create benchmark.
+      if (track_errors){
+        if (num_threads > 1){
+          add_search_types(execute_32_bit, uint32_t, 2);
+        } else {
+          add_search_types(execute_32_bit, uint32_t, 1);
+        }
+      }
+      else{
+        add_search_types(execute_32_bit, uint32_t, 0);
+      }
+      break;
+    }
+
     case DataType::STRING: {
       // Create benchmark.
       if (track_errors){
@@ -2,16 +2,30 @@
 
 #include <immintrin.h>
 #include <math.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #include <algorithm>
+#include <cerrno>
 #include <dtl/thread.hpp>
 #include <fstream>
+#include <functional>
 #include <iostream>
+#include <optional>
 #include <sstream>
 #include <regex>
 
 #include "util.h"
-#include <boost/chrono.hpp>
+#include "searches/search.h"
+#include "utils/latency_histogram.h"
+#include "utils/perf_event.h"
+#include "utils/snapshot.h"
+#include "utils/thread_pool.h"
+#include "utils/timer.h"
+#include "utils/workload_format.h"
 
 #ifdef __linux__
 #define checkLinux(x) (x)
@@ -41,15 +55,21 @@ static void wipe_cache(){
 
 #define timing_end()                                                                                     \
   if constexpr (multithread){                                                                            \
-    const auto end_time = boost::chrono::thread_clock::now();                                            \
-    timing = boost::chrono::duration_cast<boost::chrono::nanoseconds>(end_time - thread_clock_start)     \
-        .count();                                                                                        \
+    timing = util::ThreadTimer::ElapsedNs(timer_start, util::ThreadTimer::Now());                        \
   } else {                                                                                               \
-    const auto end_time = std::chrono::high_resolution_clock::now();                                     \
-    timing = std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - hr_clock_start)             \
-        .count();                                                                                        \
+    timing = util::Timer::ElapsedNs(timer_start, util::Timer::Now());                                    \
   } 
 
+template <class KeyType>
+static void VerifyLookup(const util::DataSpan<KeyType>& keys, const KeyType lookup_key, const uint64_t expected, const size_t idx) {
+  if ((expected == util::NOT_FOUND && idx != util::OVERFLOW) || (expected == 0 && (idx >= keys.size() || keys[idx] != lookup_key))){
+    std::cerr << "Lookup returned wrong result:" << std::endl;
+    std::cerr << "Lookup key: " << lookup_key << std::endl;
+    std::cerr << "Actual array index: " << idx << ", Expected positive: " << (expected != util::NOT_FOUND) << std::endl;
+    run_failed = true;
+  }
+}
+
 // multithread: whether executed in concurrency scenarios
 // time_each: whether execute latency of each operation
 // fence: whether execute memory fence after each operation
@@ -59,30 +79,50 @@ template <bool multithread, class KeyType, class Index, bool time_each, bool fen
 static void* DoOpsCoreLoop(void* param) {
   FGParam &thread_param = *(FGParam *)param;
   Index* index = (Index *)thread_param.index;
-  const std::vector<Operation<KeyType>> &ops = *(std::vector<Operation<KeyType>> *)thread_param.ops;
-  const std::vector<KeyType> &keys = *(std::vector<KeyType> *)thread_param.keys;
-  uint64_t *individual_ns = thread_param.individual_ns;
+  const util::DataSpan<Operation<KeyType>> *span = (util::DataSpan<Operation<KeyType>> *)thread_param.ops;
+  util::WorkloadStream<KeyType> *stream = (util::WorkloadStream<KeyType> *)thread_param.stream;
+  const util::DataSpan<KeyType> &keys = *(util::DataSpan<KeyType> *)thread_param.keys;
+  util::LatencyHistogram *latencies = thread_param.latencies;
   size_t start = thread_param.start, limit = thread_param.limit;
   uint32_t thread_id = thread_param.thread_id;
+  // Runs of consecutive lookups are issued in batches of up to batch_size keys.
+  const size_t batch_size = thread_param.batch_size;
+  std::vector<KeyType> batch_keys(batch_size);
+  std::vector<size_t> batch_results(batch_size);
 
-  // std::cout << "[micro] Worker" << thread_id << " Ready.\n";
-  util::ready_threads++;
-  while (!util::running)
-    ;
+  // Operations [window_start, window_end) are available at ops[0, window_end - window_start):
+  // all of them for mapped workloads, one decoded chunk at a time for columnar ones.
+  const Operation<KeyType>* ops = nullptr;
+  size_t window_start = start, window_end = start;
 
-  boost::chrono::thread_clock::time_point thread_clock_start;
-  std::chrono::high_resolution_clock::time_point hr_clock_start;
+  [[maybe_unused]] uint64_t timer_start = 0;
   bool flag = false;
   for (size_t idx = start; idx < limit; ++idx) {
-    if (!util::running && !flag){
+    if (thread_param.stop && !flag){
       flag = true;
       thread_param.op_cnt = idx - start;
     }
 
-    const uint8_t op = ops[idx].op;
-    const KeyType lo_key = ops[idx].lo_key;
-    const KeyType hi_key = ops[idx].hi_key;
-    const uint64_t expected = ops[idx].result;
+    if (idx == window_end){
+      size_t n = limit - start;
+      ops = stream ? stream->Next(n) : span->data() + start;
+      window_start = idx;
+      window_end = idx + n;
+    }
+    const Operation<KeyType>& cur = ops[idx - window_start];
+    const uint8_t op = cur.op;
+    const KeyType lo_key = cur.lo_key;
+    const KeyType hi_key = cur.hi_key;
+    const uint64_t expected = cur.result;
+
+    size_t batch_cnt = 1;
+    if (batch_size > 1 && op == util::LOOKUP){
+      batch_cnt = 0;
+      while (batch_cnt < batch_size && idx + batch_cnt < window_end && ops[idx + batch_cnt - window_start].op == util::LOOKUP){
+        batch_keys[batch_cnt] = ops[idx + batch_cnt - window_start].lo_key;
+        ++batch_cnt;
+      }
+    }
 
     if constexpr (clear_cache) {
       wipe_cache();
@@ -91,11 +131,37 @@ static void* DoOpsCoreLoop(void* param) {
     uint64_t timing = 0;
     if constexpr (time_each) {
       if constexpr (multithread){
-        thread_clock_start = boost::chrono::thread_clock::now();
+        timer_start = util::ThreadTimer::Now();
       }
       else{
-        hr_clock_start = std::chrono::high_resolution_clock::now();
+        timer_start = util::Timer::Now();
+      }
+    }
+
+    if (batch_cnt > 1){
+      if (!index->EqualityLookupBatch(batch_keys.data(), batch_cnt, batch_results.data(), thread_id)){
+        for (size_t j = 0; j < batch_cnt; ++j){
+          batch_results[j] = index->EqualityLookup(batch_keys[j], thread_id);
+        }
+      }
+      if constexpr (time_each) {
+        timing_end();
+
+        if constexpr (verify) {
+          for (size_t j = 0; j < batch_cnt; ++j){
+            VerifyLookup(keys, batch_keys[j], ops[idx + j - window_start].result, batch_results[j]);
+          }
+        }
+        // The batch is timed as a whole, so each lookup is charged an equal share.
+        latencies->Record(timing / batch_cnt, batch_cnt);
+      }
+      idx += batch_cnt - 1;
+
+      if (run_failed){
+        return nullptr;
       }
+      if constexpr (fence) __sync_synchronize();
+      continue;
     }
 
     switch (op) {
@@ -105,12 +171,7 @@ static void* DoOpsCoreLoop(void* param) {
           timing_end();
 
           if constexpr (verify) {
-            if ((expected == util::NOT_FOUND && idx != util::OVERFLOW) || (expected == 0 && (idx >= keys.size() || keys[idx] != lo_key))){
-              std::cerr << "Lookup returned wrong result:" << std::endl;
-              std::cerr << "Lookup key: " << lo_key << std::endl;
-              std::cerr << "Actual array index: " << idx << ", Expected positive: " << (expected != util::NOT_FOUND) << std::endl;
-              run_failed = true;
-            }
+            VerifyLookup(keys, lo_key, expected, idx);
           }
         }
         break;
@@ -141,6 +202,22 @@ static void* DoOpsCoreLoop(void* param) {
         break;
       }
 
+      case util::DELETE: {
+        index->Delete(lo_key, thread_id);
+        if constexpr (time_each) {
+          timing_end();
+        }
+        break;
+      }
+
+      case util::UPDATE: {
+        index->Update({lo_key, expected}, thread_id);
+        if constexpr (time_each) {
+          timing_end();
+        }
+        break;
+      }
+
       default: {
         std::cerr << "Undefined operation: " << op << std::endl;
         run_failed = true;
@@ -152,22 +229,41 @@ static void* DoOpsCoreLoop(void* param) {
     }
 
     if constexpr (time_each){
-      individual_ns[idx - start] = timing;
+      latencies->Record(timing);
     }
     
     if constexpr (fence) __sync_synchronize();
   }
 
   if (!flag){
-    util::running = false;
+    for (uint32_t i = 0; i < thread_param.num_threads; ++i){
+      thread_param.peers[i].stop = true;
+    }
     thread_param.op_cnt = limit - start;
   }
   return nullptr;
 }
 
+// Hardware counters reported per operation in --perf mode.
+static const std::vector<std::string> perf_counter_names = {
+  "cycles", "instructions", "L1-misses", "LLC-misses", "branch-misses", "dTLB-misses"};
+
 struct LatencyStat {
   double avg, mean_square;
-  uint64_t p50, p99, p999, max;
+  std::vector<uint64_t> percentiles;
+  uint64_t max;
+  // Latencies of all threads, merged.
+  util::LatencyHistogram histogram;
+};
+
+// Measurement of a tuning candidate on a sample of the workload.
+struct TuneResult {
+  bool ok;
+  // Name and variants of the index, comma-separated.
+  std::string label;
+  uint64_t build_ns;
+  size_t size;
+  double throughput;
 };
 
 // KeyType: Controls the type of the key (the value will always be uint64_t)
@@ -179,7 +275,10 @@ class Benchmark {
             const size_t num_repeats,
             const bool through, const bool build, const bool fence,
             const bool cold_cache, const bool track_errors, const bool csv,
-            const size_t num_threads, const bool verify)
+            const size_t num_threads, const size_t build_threads,
+            const bool verify, const bool huge_pages,
+            const size_t batch_size,
+            const std::vector<double>& percentiles, const bool perf)
       : data_filename_(data_filename),
         num_repeats_(num_repeats),
         through_(through),
@@ -189,46 +288,133 @@ class Benchmark {
         track_errors_(track_errors),
         csv_(csv),
         num_threads_(num_threads),
-        verify_(verify) {
+        build_threads_(std::max(num_threads, build_threads)),
+        verify_(verify),
+        huge_pages_(huge_pages),
+        batch_size_(std::max<size_t>(batch_size, 1)),
+        percentiles_(percentiles),
+        perf_(perf) {
     // if ((int)cold_cache + (int)perf + (int)fence > 1) {
     //   util::fail(
     //       "Can only specify one of cold cache, perf counters, or fence.");
     // }
 
+    // Map data.
+    keys_ = util::map_data<KeyType>(data_filename_, true, huge_pages);
+
+    // Check whether keys are unique.
+    unique_keys_ = util::is_unique(keys_);
+    if (unique_keys_)
+      std::cout << "Data is unique." << std::endl;
+    else
+      std::cout << "Data contains duplicates." << std::endl;
+
+    if (num_threads_ > 1){
+      pool_.reset(new util::ThreadPool(num_threads_));
+    }
+
+    if (perf_){
+      // Counters are opened by the thread they count.
+      perf_events_.resize(num_threads_);
+      if (num_threads_ > 1){
+        pool_->Run([&](uint32_t thread_id) {
+          perf_events_[thread_id].reset(new PerfEvent());
+        });
+      }
+      else{
+        perf_events_[0].reset(new PerfEvent());
+      }
+      if (perf_events_[0]->events.empty()){
+        std::cerr << "No hardware counters available (check perf_event_paranoid), "
+                     "ignoring --perf." << std::endl;
+        perf_ = false;
+        perf_events_.clear();
+      }
+    }
+
+    util::CalibrateTimers();
+
+    if (cold_cache_){
+      util::FastRandom ranny(8128);
+      for (uint64_t& iter : memory) {
+        iter = ranny.RandUint32();
+      }
+    }
+
+    LoadWorkload(ops_filename);
+  }
+
+  // Maps the workload `ops_filename`, replacing the current one. The keys
+  // stay mapped, so that a suite of workloads on one dataset loads them once,
+  // and so does the bulk-loaded data while it does not change.
+  void LoadWorkload(const std::string& ops_filename) {
+    ops_.clear();
+    workload_.reset();
+    streams_.clear();
+    op_runs_.clear();
+
     static constexpr const char* prefix = "data/";
     dataset_name_ = ops_filename.data();
     dataset_name_.erase(
         dataset_name_.begin(),
         dataset_name_.begin() + dataset_name_.find(prefix) + strlen(prefix));
 
-    // Load data.
-    keys_ = util::load_data<KeyType>(data_filename_);
-
-    // Load lookups.
-    if (num_threads_ > 1){
-      ops_ = util::load_data_multithread<Operation<KeyType>>(ops_filename);
+    // Map lookups.
+    bool is_mix;
+    if constexpr (std::is_integral<KeyType>::value){
+      if (util::is_columnar_workload(ops_filename)){
+        workload_ = std::make_shared<const util::WorkloadFile<KeyType>>(ops_filename, true, huge_pages_);
+        if (workload_->num_threads() != num_threads_){
+          util::fail("Workload was generated for " + std::to_string(workload_->num_threads()) + " threads.");
+        }
+        for (size_t i = 0; i < num_threads_; ++i){
+          streams_.emplace_back(new util::WorkloadStream<KeyType>(workload_, i));
+          op_runs_.push_back(workload_->Runs(i));
+        }
+      }
     }
-    else{
-      ops_.push_back(util::load_data<Operation<KeyType>>(ops_filename));
+    if (workload_){
+      // Columnar workloads carry their parameters.
+      const util::WorkloadHeader& header = workload_->header();
+      is_mix = header.mix;
+      num_blocks_ = header.num_blocks;
+      is_range_query_ = header.range_query_ratio > 0;
+      insert_ratio_ = header.insert_ratio;
+      delete_ratio_ = header.delete_ratio;
+      update_ratio_ = header.update_ratio;
     }
+    else{
+      if (num_threads_ > 1){
+        ops_ = util::map_data_multithread<Operation<KeyType>>(ops_filename, true, huge_pages_);
+      }
+      else{
+        ops_.push_back(util::map_data<Operation<KeyType>>(ops_filename, true, huge_pages_));
+      }
 
-    bool is_mix = dataset_name_.find("mix") != std::string::npos;
+      is_mix = dataset_name_.find("mix") != std::string::npos;
 
-    std::regex rq_pat("(\\d+\\.\\d*)rq"), i_pat("(\\d+\\.\\d*)i"), blk_pat("(\\d+)blk");
-    std::smatch rq_result, i_result, blk_result;
-    std::regex_search(dataset_name_, blk_result, blk_pat);
-    if (blk_result.size() > 1){
-      num_blocks_ = std::stoi(blk_result[1]);
-    }
-    else{
-      num_blocks_ = 1;
-    }
+      std::regex rq_pat("(\\d+\\.\\d*)rq"), i_pat("(\\d+\\.\\d*)i"), blk_pat("(\\d+)blk");
+      std::smatch rq_result, i_result, blk_result;
+      std::regex_search(dataset_name_, blk_result, blk_pat);
+      if (blk_result.size() > 1){
+        num_blocks_ = std::stoi(blk_result[1]);
+      }
+      else{
+        num_blocks_ = 1;
+      }
 
-    std::regex_search(dataset_name_, rq_result, rq_pat);
-    is_range_query_ = std::stod(rq_result[1]) > 0;
+      std::regex_search(dataset_name_, rq_result, rq_pat);
+      is_range_query_ = std::stod(rq_result[1]) > 0;
 
-    std::regex_search(dataset_name_, i_result, i_pat);
-    insert_ratio_ = std::stod(i_result[1]);
+      std::regex_search(dataset_name_, i_result, i_pat);
+      insert_ratio_ = std::stod(i_result[1]);
+
+      // Deletes and updates are only named when there are some.
+      std::regex d_pat("(\\d+\\.\\d*)d(_|$)"), u_pat("(\\d+\\.\\d*)u(_|$)");
+      std::smatch d_result, u_result;
+      delete_ratio_ = std::regex_search(dataset_name_, d_result, d_pat) ? std::stod(d_result[1]) : 0;
+      update_ratio_ = std::regex_search(dataset_name_, u_result, u_pat) ? std::stod(u_result[1]) : 0;
+    }
     flag_ = is_mix || (insert_ratio_ == 0) || (insert_ratio_ == 1);
 
     if (num_blocks_ > 1 && (num_threads_ > 1 || flag_)){
@@ -236,81 +422,172 @@ class Benchmark {
         "Can not use block-wise loading with multi-thread or mixed scenario.");
     }
 
+    // An empty filename stands for all keys.
+    std::string bl_filename;
     if (insert_ratio_ > 0 || dataset_name_.find("bulkload") != std::string::npos) {
-      std::string bl_filename = ops_filename + "_bulkload";
-      index_data_ = util::load_data<KeyValue<KeyType>>(bl_filename);
+      bl_filename = ops_filename + "_bulkload";
     }
-    else {
-      if (!is_sorted(keys_.begin(), keys_.end()))
-        util::fail("Keys have to be sorted.");
-      // Add artificial values to keys.
-      index_data_ = util::add_values(keys_);
+    if (!index_data_loaded_ || bl_filename != bl_filename_) {
+      if (!bl_filename.empty()) {
+        index_data_ = util::load_data<KeyValue<KeyType>>(bl_filename);
+      }
+      else {
+        if (!std::is_sorted(keys_.begin(), keys_.end()))
+          util::fail("Keys have to be sorted.");
+        // Add artificial values to keys.
+        index_data_ = util::add_values(keys_);
+      }
+      bl_filename_ = bl_filename;
+      index_data_loaded_ = true;
+      data_hash_ = 0;
     }
 
     
     if (num_blocks_ > 1){
       bound_points.resize((num_blocks_ << 1) + 1);
-      size_t ind = 0, blk_cnt = 0;
-
-      size_t cur = bound_points[0] = 0;
+      bound_points[0] = 0;
       for (size_t j = 1; j < (num_blocks_ << 1) + 1; ++ j){
-        while(cur < ops_[0].size()){
-          if ((ops_[0][cur].op == util::INSERT) ^ (j & 1)){
-            bound_points[j] = cur;
-            break;
-          }
-          ++ cur;
-        }
-        if (cur == ops_[0].size()){
-          bound_points[j] = cur;
-        }
-        blk_cnt = bound_points[j] - bound_points[j - 1];
-        ind = std::max(blk_cnt, ind);
+        bound_points[j] = FindOp(0, bound_points[j - 1], !(j & 1));
       }
-      individual_ns = new uint64_t[ind];
     }
     else{
       bound_points.resize(3 * num_threads_);
-      size_t tot_cnt = 0, insert_cnt = 0;
       for (size_t i = 0; i < num_threads_; ++ i){
         bound_points[3 * i] = 0;
         if (!flag_){
-          bound_points[3 * i + 1] = std::lower_bound(ops_[i].begin(), ops_[i].end(), 1, 
-                                                    [](const Operation<KeyType>& e, const int key){
-                                                        return (e.op != util::INSERT) < key;
-                                                      }) - ops_[i].begin();
-          insert_cnt += bound_points[3 * i + 1];
-        }
-        bound_points[3 * i + 2] = ops_[i].size();
-        tot_cnt += bound_points[3 * i + 2];
+          if (workload_){
+            bound_points[3 * i + 1] = FindOp(i, 0, false);
+          }
+          else{
+            bound_points[3 * i + 1] = std::lower_bound(ops_[i].begin(), ops_[i].end(), 1, 
+                                                      [](const Operation<KeyType>& e, const int key){
+                                                          return (e.op != util::INSERT) < key;
+                                                        }) - ops_[i].begin();
+          }
+        }
+        bound_points[3 * i + 2] = NumOps(i);
       };
-      individual_ns = new uint64_t[std::max(insert_cnt, tot_cnt - insert_cnt)];
     }
+    thread_latencies_.resize(num_threads_);
+  }
 
-    // Check whether keys are unique.
-    unique_keys_ = util::is_unique(keys_);
-    if (unique_keys_)
-      std::cout << "Data is unique." << std::endl;
-    else
-      std::cout << "Data contains duplicates." << std::endl;
+  // Runs every repeat in a child process forked from a single build instead
+  // of rebuilding the index, for indexes run by one thread without threads
+  // of their own.
+  void EnableForkRepeats() {
+    fork_repeats_ = true;
+  }
 
-    if (cold_cache_){
-      util::FastRandom ranny(8128);
-      for (uint64_t& iter : memory) {
-        iter = ranny.RandUint32();
-      }
+  // Caches snapshots of the indexes that support them in `dir`: an index
+  // saved for the same bulk-loaded data and variants is reloaded instead of
+  // built, and its reload time reported as build time.
+  void SetSnapshotDir(const std::string& dir) {
+    if (mkdir(dir.c_str(), 0755) != 0 && errno != EEXIST){
+      util::fail("unable to create snapshot directory " + dir);
     }
+    snapshot_dir_ = dir;
   }
-  ~Benchmark(){
-    delete[] individual_ns;
+
+  // Makes Run() only register its index as a candidate for Tune(), which
+  // first measures every candidate on `sample_ops` operations per thread.
+  // Candidates larger than `memory_budget` bytes are dropped (0: no budget).
+  void EnableTuning(size_t sample_ops, size_t memory_budget) {
+    if (build_){
+      util::fail("Can not tune when only measuring build times.");
+    }
+    tune_ = true;
+    tune_ops_ = std::max<size_t>(sample_ops, 1);
+    memory_budget_ = memory_budget;
+  }
+
+  // Successive halving over the registered candidates: every round measures
+  // the remaining ones on the sample, keeps the better half by the number of
+  // candidates dominating them in both throughput and size (and at least all
+  // undominated ones), then doubles the sample until only the Pareto frontier
+  // remains or the whole workload was used. Prints that frontier.
+  void Tune() {
+    if (!tune_ || tune_candidates_.empty()) return;
+
+    size_t max_ops = 0;
+    for (size_t i = 0; i < num_threads_; ++i){
+      max_ops = std::max(max_ops, NumOps(i));
+    }
+
+    std::vector<TuneResult> results(tune_candidates_.size());
+    std::vector<size_t> alive(tune_candidates_.size());
+    for (size_t i = 0; i < alive.size(); ++i){
+      alive[i] = i;
+    }
+    size_t sample = tune_ops_;
+    while (true){
+      const bool full = sample >= max_ops;
+      std::cout << "Tuning " << alive.size() << " candidate(s) on "
+                << (full ? max_ops : sample) << " operation(s) per thread." << std::endl;
+      for (size_t i: alive){
+        results[i] = tune_candidates_[i](full ? 0 : sample);
+      }
+      alive.erase(std::remove_if(alive.begin(), alive.end(), [&](size_t i){
+                    return !results[i].ok || (memory_budget_ > 0 && results[i].size > memory_budget_);
+                  }), alive.end());
+
+      std::vector<size_t> dominators(tune_candidates_.size(), 0);
+      size_t frontier = 0;
+      for (size_t i: alive){
+        for (size_t j: alive){
+          dominators[i] += Dominates(results[j], results[i]);
+        }
+        frontier += dominators[i] == 0;
+      }
+      std::sort(alive.begin(), alive.end(), [&](size_t a, size_t b){
+        return dominators[a] != dominators[b] ? dominators[a] < dominators[b]
+                                              : results[a].throughput > results[b].throughput;
+      });
+      if (full || frontier == alive.size()){
+        alive.resize(frontier);
+        break;
+      }
+      alive.resize(std::max(frontier, (alive.size() + 1) / 2));
+      sample = std::min(sample * 2, max_ops);
+    }
+
+    if (alive.empty()){
+      std::cout << "No candidate fits the memory budget." << std::endl;
+      return;
+    }
+    std::sort(alive.begin(), alive.end(), [&](size_t a, size_t b){
+      return results[a].size < results[b].size;
+    });
+    for (size_t i: alive){
+      std::cout << "TUNE: " << FormatTuneResult(results[i], std::min(sample, max_ops)) << std::endl;
+    }
+    if (csv_){
+      const std::string filename =
+          "./results/" + dataset_name_ + "_tune_results.csv";
+      std::ofstream fout(filename, std::ofstream::out | std::ofstream::app);
+      if (!fout.is_open()) {
+        std::cerr << "Failure to print CSV on " << filename << std::endl;
+        return;
+      }
+      for (size_t i: alive){
+        fout << FormatTuneResult(results[i], std::min(sample, max_ops)) << std::endl;
+      }
+    }
+    tune_candidates_.clear();
   }
 
   template <class Index>
   void Run(const std::vector<int>& params = std::vector<int>()) {
+    if (tune_){
+      tune_candidates_.push_back([this, params](size_t sample_ops) {
+        return Measure<Index>(params, sample_ops);
+      });
+      return;
+    }
+
     // Build index.
     Index* index = new Index(params);
 
-    if (!index->applicable(unique_keys_, is_range_query_, insert_ratio_ > 0, num_threads_ > 1, dataset_name_)) {
+    if (!Applicable(index)) {
       std::cout << "Index " << index->name() << " is not applicable"
                 << std::endl;
       delete index;
@@ -322,9 +599,11 @@ class Benchmark {
     run_failed = false;
 
     build_ns_.clear();
+    perf_counters_.clear();
 
     if (through_){
       throughputs_.clear();
+      thread_throughputs_.clear();
     }else{
       latencies_.clear();
       if (track_errors_){
@@ -334,43 +613,36 @@ class Benchmark {
       }
     }
 
-    for (size_t i = 0; i < num_repeats_; i ++){
-      if (i > 0){
-        delete index;
-        index = new Index(params);
-      }
-
-      build_ns_.push_back(index->Build(index_data_, num_threads_));
+    // Forked repeats start from the first build, unless the index owns
+    // threads, which a forked child does not inherit.
+    const bool fork_repeats = fork_repeats_ && num_threads_ == 1 && index->forkable();
+    if (fork_repeats_ && !fork_repeats){
+      std::cout << "Rebuilding " << index->name() << " for every repeat, "
+                << "as it can not run in a forked process." << std::endl;
+    }
+    forked_size_.reset();
 
-      // Do operations.
-      if (through_) {
-        if (fence_) {
-          DoOps<Index, false, true, false, false>(index);
-        } else{
-          DoOps<Index, false, false, false, false>(index);
-        }
-      } else if (cold_cache_) {
-        if (num_threads_ > 1)
-          util::fail("Cold cache not supported with multiple threads.");
-        if (verify_){
-          DoOps<Index, true, false, true, true>(index);
-        } else{
-          DoOps<Index, true, false, true, false>(index);
+    for (size_t i = 0; i < num_repeats_; i ++){
+      if (fork_repeats){
+        if (i == 0){
+          build_ns_.push_back(BuildOrLoad(index));
         }
-      } else if (fence_) {
-        if (verify_){
-          DoOps<Index, true, true, false, true>(index);
-        } else {
-          DoOps<Index, true, true, false, false>(index);
+        else{
+          build_ns_.push_back(build_ns_.front());
         }
-      } else {
-        if (verify_){
-          DoOps<Index, true, false, false, true>(index);
-        } else {
-          DoOps<Index, true, false, false, false>(index);
+        RunOpsForked(index);
+      }
+      else{
+        if (i > 0){
+          delete index;
+          index = new Index(params);
+          Applicable(index);
         }
+
+        build_ns_.push_back(BuildOrLoad(index));
+        RunOps(index);
       }
-      
+
       if (run_failed) {
         delete index;
         return;
@@ -381,6 +653,306 @@ class Benchmark {
   }
 
  private:
+  // Whether the index can run the workload. Deletes and updates need a
+  // deletable index; read-only workloads run from several threads on
+  // indexes prepared for concurrent reads; the rest is up to the index's
+  // applicable().
+  template <class Index>
+  bool Applicable(Index* index) {
+    if ((delete_ratio_ > 0 || update_ratio_ > 0) && !index->deletable()){
+      return false;
+    }
+    const bool writes = insert_ratio_ > 0 || delete_ratio_ > 0 || update_ratio_ > 0;
+    const bool concurrent_reads = num_threads_ > 1 && !writes && index->concurrentReads();
+    return index->applicable(unique_keys_, is_range_query_, writes,
+                             num_threads_ > 1 && !concurrent_reads, dataset_name_);
+  }
+
+  // Runs the operations on the built index, measured as the options ask.
+  template <class Index>
+  void RunOps(Index* index) {
+    if (through_) {
+      if (fence_) {
+        DoOps<Index, false, true, false, false>(index);
+      } else{
+        DoOps<Index, false, false, false, false>(index);
+      }
+    } else if (cold_cache_) {
+      if (num_threads_ > 1)
+        util::fail("Cold cache not supported with multiple threads.");
+      if (verify_){
+        DoOps<Index, true, false, true, true>(index);
+      } else{
+        DoOps<Index, true, false, true, false>(index);
+      }
+    } else if (fence_) {
+      if (verify_){
+        DoOps<Index, true, true, false, true>(index);
+      } else {
+        DoOps<Index, true, true, false, false>(index);
+      }
+    } else {
+      if (verify_){
+        DoOps<Index, true, false, false, true>(index);
+      } else {
+        DoOps<Index, true, false, false, false>(index);
+      }
+    }
+  }
+
+  // Runs the operations of one repeat in a child process forked from the
+  // built index, so that every repeat starts from an identical copy-on-write
+  // image of it, and appends the metrics the child sends through a pipe.
+  template <class Index>
+  void RunOpsForked(Index* index) {
+    int fds[2];
+    if (pipe(fds) != 0){
+      util::fail("unable to create a pipe");
+    }
+    std::cout.flush();
+    std::cerr.flush();
+    const pid_t pid = fork();
+    if (pid < 0){
+      util::fail("unable to fork");
+    }
+
+    if (pid == 0){
+      close(fds[0]);
+#ifdef _OPENMP
+      // The OpenMP workers of the parent do not exist in the child.
+      omp_set_num_threads(1);
+#endif
+      if (perf_){
+        // Counters count the thread that opened them.
+        perf_events_[0].reset(new PerfEvent());
+      }
+      const ForkedMetrics first = CountMetrics();
+      RunOps(index);
+      std::string out;
+      SerializeMetrics(first, index->size(), out);
+      for (size_t written = 0; written < out.size(); ){
+        const ssize_t n = write(fds[1], out.data() + written, out.size() - written);
+        if (n <= 0) break;
+        written += n;
+      }
+      close(fds[1]);
+      std::cout.flush();
+      std::cerr.flush();
+      _exit(0);
+    }
+
+    close(fds[1]);
+    std::string in;
+    char buffer[1 << 16];
+    ssize_t n;
+    while ((n = read(fds[0], buffer, sizeof(buffer))) > 0){
+      in.append(buffer, n);
+    }
+    close(fds[0]);
+    int status;
+    waitpid(pid, &status, 0);
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0 || in.empty()){
+      std::cerr << "Forked repeat of " << index->name() << " did not complete." << std::endl;
+      run_failed = true;
+      return;
+    }
+    DeserializeMetrics(in);
+  }
+
+  // Numbers of metrics collected so far.
+  struct ForkedMetrics {
+    size_t throughputs, latencies, search_stats, perf_counters;
+  };
+
+  ForkedMetrics CountMetrics() const {
+    return ForkedMetrics{throughputs_.size(), latencies_.size(),
+                         search_times_.size(), perf_counters_.size()};
+  }
+
+  // Appends to `out` the failure flag, the index size and the metrics
+  // collected since `first`.
+  void SerializeMetrics(const ForkedMetrics& first, size_t index_size, std::string& out) const {
+    util::AppendPod(out, static_cast<uint8_t>(run_failed));
+    util::AppendPod(out, index_size);
+    util::AppendVector(out, throughputs_, first.throughputs);
+    util::AppendPod(out, latencies_.size() - first.latencies);
+    for (size_t i = first.latencies; i < latencies_.size(); ++i){
+      const LatencyStat& stat = latencies_[i];
+      util::AppendPod(out, stat.avg);
+      util::AppendPod(out, stat.mean_square);
+      util::AppendVector(out, stat.percentiles, 0);
+      util::AppendPod(out, stat.max);
+      stat.histogram.Serialize(out);
+    }
+    util::AppendVector(out, search_bounds_, first.search_stats);
+    util::AppendVector(out, search_times_, first.search_stats);
+    util::AppendVector(out, search_latencies_, first.search_stats);
+    util::AppendPod(out, perf_counters_.size() - first.perf_counters);
+    for (size_t i = first.perf_counters; i < perf_counters_.size(); ++i){
+      util::AppendVector(out, perf_counters_[i], 0);
+    }
+  }
+
+  // Appends the metrics serialized by a forked repeat.
+  void DeserializeMetrics(const std::string& in) {
+    const char* pos = in.data();
+    run_failed = util::ReadPod<uint8_t>(pos);
+    forked_size_ = util::ReadPod<size_t>(pos);
+    util::ReadVector(pos, throughputs_);
+    const size_t num_latencies = util::ReadPod<size_t>(pos);
+    for (size_t i = 0; i < num_latencies; ++i){
+      LatencyStat stat;
+      stat.avg = util::ReadPod<double>(pos);
+      stat.mean_square = util::ReadPod<double>(pos);
+      util::ReadVector(pos, stat.percentiles);
+      stat.max = util::ReadPod<uint64_t>(pos);
+      stat.histogram.Deserialize(pos);
+      latencies_.push_back(std::move(stat));
+    }
+    util::ReadVector(pos, search_bounds_);
+    util::ReadVector(pos, search_times_);
+    util::ReadVector(pos, search_latencies_);
+    const size_t num_perf_counters = util::ReadPod<size_t>(pos);
+    for (size_t i = 0; i < num_perf_counters; ++i){
+      perf_counters_.emplace_back();
+      util::ReadVector(pos, perf_counters_.back());
+    }
+  }
+
+  // Size of the index after the operations, which forked repeats report.
+  template <class Index>
+  size_t IndexSize(const Index* index) const {
+    return forked_size_ ? *forked_size_ : index->size();
+  }
+
+  // Builds the index and measures its throughput on the first `sample_ops`
+  // operations of every thread (0: all of them).
+  template <class Index>
+  TuneResult Measure(const std::vector<int>& params, size_t sample_ops) {
+    TuneResult result{false, "", 0, 0, 0};
+    Index* index = new Index(params);
+    if (!Applicable(index)) {
+      delete index;
+      return result;
+    }
+
+    run_failed = false;
+    throughputs_.clear();
+    thread_throughputs_.clear();
+    perf_counters_.clear();
+    sample_ops_ = sample_ops;
+    result.build_ns = BuildOrLoad(index);
+    DoOps<Index, false, false, false, false>(index);
+    sample_ops_ = 0;
+
+    result.ok = !run_failed;
+    result.size = index->size();
+    result.label = index->name();
+    for (auto str: index->variants()){
+      result.label += "," + str;
+    }
+    for (auto t: throughputs_){
+      result.throughput += t / throughputs_.size();
+    }
+    delete index;
+    return result;
+  }
+
+  // Builds the index, or reloads it from the snapshot cache.
+  template <class Index>
+  uint64_t BuildOrLoad(Index* index) {
+    if (snapshot_dir_.empty()){
+      return index->Build(index_data_, build_threads_);
+    }
+    const std::string filename = SnapshotFilename(index);
+    bool loaded = false;
+    const uint64_t load_ns = util::timing([&] { loaded = index->Load(filename); });
+    if (loaded){
+      std::cout << "Loaded snapshot " << filename << std::endl;
+      return load_ns;
+    }
+    const uint64_t build_ns = index->Build(index_data_, build_threads_);
+    if (index->Save(filename)){
+      std::cout << "Saved snapshot " << filename << std::endl;
+    }
+    return build_ns;
+  }
+
+  // "{dir}/{name}_{variants}_{hash of the bulk-loaded data}.snap", with
+  // characters other than letters, digits, '.', '-' and '_' replaced by '-'.
+  template <class Index>
+  std::string SnapshotFilename(const Index* index) {
+    if (data_hash_ == 0){
+      // FNV-1a over the keys and payloads, a word at a time for integer keys.
+      data_hash_ = 14695981039346656037ull;
+      auto mix = [&](uint64_t word) { data_hash_ = (data_hash_ ^ word) * 1099511628211ull; };
+      for (const auto& kv: index_data_){
+        if constexpr (std::is_same<KeyType, std::string>::value){
+          for (char c: kv.key){
+            mix(static_cast<uint8_t>(c));
+          }
+        }
+        else{
+          mix(kv.key);
+        }
+        mix(kv.value);
+      }
+    }
+
+    std::string name = index->name();
+    for (const auto& str: index->variants()){
+      name += "_" + str;
+    }
+    for (char& c: name){
+      if (!isalnum(c) && c != '.' && c != '-' && c != '_'){
+        c = '-';
+      }
+    }
+    std::stringstream ss;
+    ss << snapshot_dir_ << "/" << name << "_" << std::hex << data_hash_ << ".snap";
+    return ss.str();
+  }
+
+  // Whether `a` is at least as fast and as small as `b`, and better in one.
+  static bool Dominates(const TuneResult& a, const TuneResult& b) {
+    return a.throughput >= b.throughput && a.size <= b.size &&
+           (a.throughput > b.throughput || a.size < b.size);
+  }
+
+  // "name,build_us,size,throughput,sample_ops,variants...".
+  static std::string FormatTuneResult(const TuneResult& result, size_t sample_ops) {
+    const size_t name_end = std::min(result.label.find(','), result.label.size());
+    std::stringstream ss;
+    ss << result.label.substr(0, name_end) << "," << result.build_ns / 1000 << ","
+       << result.size << "," << result.throughput << "," << sample_ops
+       << result.label.substr(name_end);
+    return ss.str();
+  }
+
+  // Number of operations of a thread.
+  size_t NumOps(size_t thread) const {
+    return workload_ ? workload_->size(thread) : ops_[thread].size();
+  }
+
+  // First operation of a thread from `from` on that is an insert iff `insert`,
+  // or the number of operations if there is none.
+  size_t FindOp(size_t thread, size_t from, bool insert) const {
+    if (workload_){
+      size_t pos = 0;
+      for (const auto& run: op_runs_[thread]){
+        if (pos + run.second > from && (run.first == util::INSERT) == insert){
+          return std::max(pos, from);
+        }
+        pos += run.second;
+      }
+      return pos;
+    }
+    size_t cur = from;
+    while (cur < ops_[thread].size() && (ops_[thread][cur].op == util::INSERT) != insert){
+      ++ cur;
+    }
+    return cur;
+  }
 
   template <class Index, bool time_each, bool fence, bool clear_cache, bool verify>
   void DoOps(Index* index) {
@@ -389,7 +961,7 @@ class Benchmark {
     for (size_t i = 0; i < (2 - flag_) * num_blocks_; ++i){
       if constexpr (time_each){
         if (track_errors_){
-          index->initSearch();
+          index->initSearch(num_threads_);
         }
       }
 
@@ -401,15 +973,21 @@ class Benchmark {
         }
       }
 
-      util::running = false;
-      util::ready_threads = 0;
       size_t exe_cnt = 0;
       for (size_t worker_i = 0; worker_i < num_threads_; worker_i++) {
         fg_params[worker_i].index = index;
-        fg_params[worker_i].ops = &ops_[worker_i];
+        fg_params[worker_i].ops = workload_ ? nullptr : &ops_[worker_i];
+        fg_params[worker_i].stream = workload_ ? streams_[worker_i].get() : nullptr;
         fg_params[worker_i].keys = &keys_;
-        fg_params[worker_i].individual_ns = individual_ns + exe_cnt;
+        fg_params[worker_i].latencies = &thread_latencies_[worker_i];
         fg_params[worker_i].thread_id = worker_i;
+        fg_params[worker_i].num_threads = num_threads_;
+        fg_params[worker_i].peers = fg_params;
+        fg_params[worker_i].stop = false;
+        fg_params[worker_i].batch_size = batch_size_;
+        if constexpr (time_each){
+          thread_latencies_[worker_i].Reset();
+        }
         if (num_blocks_ > 1){
           fg_params[worker_i].start = bound_points[i];
           fg_params[worker_i].limit = bound_points[i + 1];
@@ -419,40 +997,72 @@ class Benchmark {
           fg_params[worker_i].limit = bound_points[3 * worker_i + i + 1 + flag_];
         }
         
+        if (sample_ops_ > 0){
+          fg_params[worker_i].limit = std::min(fg_params[worker_i].limit,
+                                               fg_params[worker_i].start + sample_ops_);
+        }
+
+        if (workload_){
+          streams_[worker_i]->Seek(fg_params[worker_i].start, fg_params[worker_i].limit);
+        }
+        
         exe_cnt += fg_params[worker_i].limit - fg_params[worker_i].start;
       }
 
       uint64_t timing;
       if (num_threads_ > 1){
-        timing = index->runMultithread(DoOpsCoreLoop<true, KeyType, Index, time_each, fence, clear_cache, verify>, fg_params);
+        timing = pool_->Run([&](uint32_t thread_id) {
+          index->initThread(thread_id);
+          SearchStats::current = index->searchStats(thread_id);
+          if (perf_) perf_events_[thread_id]->startCounters();
+          DoOpsCoreLoop<true, KeyType, Index, time_each, fence, clear_cache, verify>(&fg_params[thread_id]);
+          pool_->Finish();
+          if (perf_) perf_events_[thread_id]->stopCounters();
+          SearchStats::current = nullptr;
+          index->exitThread(thread_id);
+        });
       }
       else{
-        util::running = true;
+        index->initThread(0);
+        SearchStats::current = index->searchStats(0);
+        if (perf_) perf_events_[0]->startCounters();
         timing = util::timing([&] {
           DoOpsCoreLoop<false, KeyType, Index, time_each, fence, clear_cache, verify>(fg_params);
         });
+        if (perf_) perf_events_[0]->stopCounters();
+        SearchStats::current = nullptr;
+        index->exitThread(0);
       }
 
       if (run_failed){
         return;
       }
 
+      if (perf_){
+        std::vector<double> counters;
+        for (const auto& name: perf_counter_names){
+          double sum = 0;
+          for (auto& perf_event: perf_events_){
+            const double value = perf_event->getCounter(name);
+            sum = (value < 0 || sum < 0) ? -1 : sum + value;
+          }
+          counters.push_back(sum < 0 ? NAN : sum / exe_cnt);
+        }
+        perf_counters_.push_back(counters);
+      }
+
       if constexpr (time_each){
         LatencyStat stat;
-        double individual_ns_sum = 0;
-        double individual_square_sum = 0;
-        for (size_t i = 0; i < exe_cnt; i ++){
-          individual_square_sum += individual_ns[i] * individual_ns[i];
-          individual_ns_sum += individual_ns[i];
-        }
-        stat.mean_square = sqrt((individual_square_sum - individual_ns_sum * individual_ns_sum / exe_cnt) / (exe_cnt - 1));
-        stat.avg = individual_ns_sum / exe_cnt;
-        std::sort(individual_ns, individual_ns + exe_cnt);
-        stat.p50 = individual_ns[size_t(exe_cnt * 0.5)];
-        stat.p99 = individual_ns[size_t(exe_cnt * 0.99)];
-        stat.p999 = individual_ns[size_t(exe_cnt * 0.999)];
-        stat.max = individual_ns[exe_cnt - 1];
-        latencies_.push_back(stat);
+        for (size_t worker_i = 0; worker_i < num_threads_; worker_i++) {
+          stat.histogram.Merge(thread_latencies_[worker_i]);
+        }
+        stat.mean_square = stat.histogram.stddev();
+        stat.avg = stat.histogram.mean();
+        for (double p: percentiles_){
+          stat.percentiles.push_back(stat.histogram.Percentile(p));
+        }
+        stat.max = stat.histogram.max();
+        latencies_.push_back(std::move(stat));
         if (track_errors_){
           search_bounds_.push_back(index->searchBound());
           search_times_.push_back(index->searchAverageTime());
@@ -466,6 +1076,13 @@ class Benchmark {
         }
         throughput = throughput * 1e3 / timing;
         throughputs_.push_back(throughput);
+        if (num_threads_ > 1){
+          std::vector<double> thread_throughputs;
+          for (size_t worker_i = 0; worker_i < num_threads_; worker_i++) {
+            thread_throughputs.push_back(fg_params[worker_i].op_cnt * 1e3 / timing);
+          }
+          thread_throughputs_.push_back(std::move(thread_throughputs));
+        }
       }
     }
   }
@@ -480,7 +1097,7 @@ class Benchmark {
     for (auto b: build_ns_){
       std::cout << "," << b / 1000;
     }
-    std::cout << "," << index->size();
+    std::cout << "," << IndexSize(index) << "," << util::peak_rss();
                 
     if (!build_) {
       if (through_){
@@ -489,8 +1106,12 @@ class Benchmark {
         }
       } 
       else{
-        for (auto l: latencies_){
-          std::cout << "," << l.avg << "," << l.p50 << "," << l.p99 << "," << l.p999 << "," << l.max << "," << l.mean_square;
+        for (const auto& l: latencies_){
+          std::cout << "," << l.avg;
+          for (auto p: l.percentiles){
+            std::cout << "," << p;
+          }
+          std::cout << "," << l.max << "," << l.mean_square;
         }
 
         if (track_errors_){
@@ -499,6 +1120,12 @@ class Benchmark {
           }
         }
       } 
+
+      for (const auto& counters: perf_counters_){
+        for (auto c: counters){
+          std::cout << "," << c;
+        }
+      }
     }
 
     for (auto str: index->variants()){
@@ -509,6 +1136,38 @@ class Benchmark {
     if (csv_) {
       PrintResultCSV(index);
     }
+
+    if (!build_ && through_ && !thread_throughputs_.empty()){
+      PrintThreadResult(index);
+    }
+  }
+
+  // Prints the throughput of every thread as a
+  // "THREADS: name,block 0 thread 0,block 0 thread 1,...,variants..." line,
+  // and appends it to a CSV file without the prefix.
+  template <class Index>
+  void PrintThreadResult(const Index* index) {
+    std::string line = index->name();
+    for (const auto& block: thread_throughputs_){
+      for (auto t: block){
+        line += "," + std::to_string(t);
+      }
+    }
+    for (auto str: index->variants()){
+      line += "," + str;
+    }
+    std::cout << "THREADS: " << line << std::endl;
+
+    if (csv_){
+      const std::string filename =
+          "./results/" + dataset_name_ + "_thread_results.csv";
+      std::ofstream fout(filename, std::ofstream::out | std::ofstream::app);
+      if (!fout.is_open()) {
+        std::cerr << "Failure to print CSV on " << filename << std::endl;
+        return;
+      }
+      fout << line << std::endl;
+    }
   }
 
   template <class Index>
@@ -527,7 +1186,7 @@ class Benchmark {
     for (auto b: build_ns_){
       fout << "," << b / 1000;
     }
-    fout << "," << index->size();
+    fout << "," << IndexSize(index) << "," << util::peak_rss();
 
     if (!build_) {
       if (through_){
@@ -536,8 +1195,12 @@ class Benchmark {
         }
       } 
       else{
-        for (auto l: latencies_){
-          fout << "," << l.avg << "," << l.p50 << "," << l.p99 << "," << l.p999 << "," << l.max << "," << l.mean_square;
+        for (const auto& l: latencies_){
+          fout << "," << l.avg;
+          for (auto p: l.percentiles){
+            fout << "," << p;
+          }
+          fout << "," << l.max << "," << l.mean_square;
         }
 
         if (track_errors_){
@@ -546,6 +1209,12 @@ class Benchmark {
           }
         }
       }  
+
+      for (const auto& counters: perf_counters_){
+        for (auto c: counters){
+          fout << "," << c;
+        }
+      }
     }
 
     for (auto str: index->variants()){
@@ -553,35 +1222,77 @@ class Benchmark {
     }
     fout << std::endl; 
     fout.close();
+
+    if (!build_ && !through_) {
+      PrintHistogramCSV(index);
+    }
     return;
   }
 
+  // Appends the full latency histogram of every block as
+  // "name,variants...,block,latency_ns,count" lines.
+  template <class Index>
+  void PrintHistogramCSV(const Index* index) {
+    const std::string filename =
+        "./results/" + dataset_name_ + "_latency_histograms.csv";
+
+    std::ofstream fout(filename, std::ofstream::out | std::ofstream::app);
+
+    if (!fout.is_open()) {
+      std::cerr << "Failure to print CSV on " << filename << std::endl;
+      return;
+    }
+
+    std::string prefix = index->name();
+    for (auto str: index->variants()){
+      prefix += "," + str;
+    }
+    for (size_t i = 0; i < latencies_.size(); ++i){
+      latencies_[i].histogram.WriteCSV(fout, prefix + "," + std::to_string(i) + ",");
+    }
+    fout.close();
+  }
+
   // Dataset filename.
   const std::string data_filename_;
   // Workload filename.
   std::string dataset_name_;
   // Dataset keys.
-  std::vector<KeyType> keys_;
-  // Bulk-loaded data.
+  util::DataSpan<KeyType> keys_;
+  // Bulk-loaded data, and the file it was loaded from (empty for all keys).
   std::vector<KeyValue<KeyType>> index_data_;
+  std::string bl_filename_;
+  bool index_data_loaded_ = false;
   // Whether dataset keys are unique.
   bool unique_keys_;
   // Whether workload has range queries.
   bool is_range_query_;
   // Insert ratio of workload.
   double insert_ratio_;
+  double delete_ratio_;
+  double update_ratio_;
   // Decode workload.
-  std::vector<std::vector<Operation<KeyType>>> ops_;
+  std::vector<util::DataSpan<Operation<KeyType>>> ops_;
+  // Columnar workload, streamed to every thread instead of `ops_`.
+  std::shared_ptr<const util::WorkloadFile<KeyType>> workload_;
+  std::vector<std::unique_ptr<util::WorkloadStream<KeyType>>> streams_;
+  // Runs of equal op codes of every thread's columnar operations.
+  std::vector<std::vector<std::pair<uint8_t, uint64_t>>> op_runs_;
   std::vector<size_t> bound_points;
   size_t flag_;
   // Metrics.
   std::vector<uint64_t> build_ns_;
   std::vector<LatencyStat> latencies_;
-  uint64_t* individual_ns;
+  // Per-thread latencies of the current block.
+  std::vector<util::LatencyHistogram> thread_latencies_;
   std::vector<double> throughputs_;
+  // Throughput of every thread, per block of multithreaded runs.
+  std::vector<std::vector<double>> thread_throughputs_;
   std::vector<double> search_bounds_;
   std::vector<double> search_times_;
   std::vector<double> search_latencies_;
+  // Hardware counters per operation of every block, in perf_counter_names order.
+  std::vector<std::vector<double>> perf_counters_;
   // Options chosen.
   bool through_;
   bool build_;
@@ -591,9 +1302,36 @@ class Benchmark {
   bool track_errors_;
   bool csv_;
   bool verify_;
+  bool huge_pages_;
+  size_t batch_size_;
+  std::vector<double> percentiles_;
+  bool perf_;
+  // Hardware counters of every thread.
+  std::vector<std::unique_ptr<PerfEvent>> perf_events_;
   const size_t num_threads_;
+  // Threads available to Build(); never fewer than the worker threads, as
+  // indexes size their per-thread state by it.
+  const size_t build_threads_;
   const size_t num_repeats_;
   size_t num_blocks_;
+  // Worker threads of multithreaded runs, shared by all blocks and indexes.
+  std::unique_ptr<util::ThreadPool> pool_;
+  // Whether repeats run in children forked from one build.
+  bool fork_repeats_ = false;
+  // Index size reported by the last forked repeat.
+  std::optional<size_t> forked_size_;
+  // Directory of cached index snapshots, empty for none.
+  std::string snapshot_dir_;
+  // Hash of index_data_, computed on first use.
+  uint64_t data_hash_ = 0;
+  // Tuning: candidates registered by Run(), measuring themselves on a number
+  // of operations per thread.
+  bool tune_ = false;
+  size_t tune_ops_ = 0;
+  size_t memory_budget_ = 0;
+  // Operations per thread and block to run, 0 for all of them.
+  size_t sample_ops_ = 0;
+  std::vector<std::function<TuneResult(size_t)>> tune_candidates_;
 };
 
 }  // namespace tli
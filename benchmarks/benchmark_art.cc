@@ -8,6 +8,10 @@ void benchmark_64_art(tli::Benchmark<uint64_t>& benchmark) {
   benchmark.template Run<tli_art::ART<uint64_t>>();
 }
 
+void benchmark_32_art(tli::Benchmark<uint32_t>& benchmark) {
+  benchmark.template Run<tli_art::ART<uint32_t>>();
+}
+
 void benchmark_string_art(tli::Benchmark<std::string>& benchmark) {
   benchmark.template Run<tli_art::ART<std::string>>();
 }
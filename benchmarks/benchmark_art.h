@@ -3,4 +3,6 @@
 
 void benchmark_64_art(tli::Benchmark<uint64_t>& benchmark);
 
+void benchmark_32_art(tli::Benchmark<uint32_t>& benchmark);
+
 void benchmark_string_art(tli::Benchmark<std::string>& benchmark);
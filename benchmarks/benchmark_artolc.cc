@@ -8,6 +8,10 @@ void benchmark_64_artolc(tli::Benchmark<uint64_t>& benchmark) {
   benchmark.template Run<ARTOLC<uint64_t>>();
 }
 
+void benchmark_32_artolc(tli::Benchmark<uint32_t>& benchmark) {
+  benchmark.template Run<ARTOLC<uint32_t>>();
+}
+
 void benchmark_string_artolc(tli::Benchmark<std::string>& benchmark) {
   benchmark.template Run<ARTOLC<std::string>>();
 }
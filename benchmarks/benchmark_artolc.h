@@ -3,4 +3,6 @@
 
 void benchmark_64_artolc(tli::Benchmark<uint64_t>& benchmark);
 
+void benchmark_32_artolc(tli::Benchmark<uint32_t>& benchmark);
+
 void benchmark_string_artolc(tli::Benchmark<std::string>& benchmark);
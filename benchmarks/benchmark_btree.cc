@@ -4,23 +4,31 @@
 #include "common.h"
 #include "competitors/stx_btree.h"
 
-template <typename Searcher>
-void benchmark_64_btree(tli::Benchmark<uint64_t>& benchmark, 
-                        bool pareto, const std::vector<int>& params) {
+// Log2 of the node sizes of B+tree, in bytes.
+typedef ParamValues<6, 8, 10, 12, 14, 16, 18> btree_values;
+
+template <typename KeyType, typename Searcher>
+void benchmark_btree_sweep(tli::Benchmark<KeyType>& benchmark,
+                           bool pareto, const std::vector<int>& params) {
+  auto run = [&](auto value) {
+    benchmark.template Run<STXBTree<KeyType, Searcher, decltype(value)::value>>();
+  };
   if (!pareto){
-    util::fail("B+tree's hyperparameter cannot be set");
+    if (params.size() != 1 || !btree_values::Dispatch(params[0], run)){
+      util::fail("B+tree's node size log must be one of " + btree_values::Names());
+    }
   }
   else{
-    benchmark.template Run<STXBTree<uint64_t, Searcher, 6>>();
-    benchmark.template Run<STXBTree<uint64_t, Searcher, 8>>();
-    benchmark.template Run<STXBTree<uint64_t, Searcher, 10>>();
-    benchmark.template Run<STXBTree<uint64_t, Searcher, 12>>();
-    benchmark.template Run<STXBTree<uint64_t, Searcher, 14>>();
-    benchmark.template Run<STXBTree<uint64_t, Searcher, 16>>();
-    benchmark.template Run<STXBTree<uint64_t, Searcher, 18>>();
+    btree_values::ForEach(run);
   }
 }
 
+template <typename Searcher>
+void benchmark_64_btree(tli::Benchmark<uint64_t>& benchmark, 
+                        bool pareto, const std::vector<int>& params) {
+  benchmark_btree_sweep<uint64_t, Searcher>(benchmark, pareto, params);
+}
+
 template <int record>
 void benchmark_64_btree(tli::Benchmark<uint64_t>& benchmark, const std::string& filename) {
   if (filename.find("books_200M") != std::string::npos) {
@@ -165,4 +173,51 @@ void benchmark_64_btree(tli::Benchmark<uint64_t>& benchmark, const std::string&
   }
 }
 
+template <typename Searcher>
+void benchmark_32_btree(tli::Benchmark<uint32_t>& benchmark, 
+                        bool pareto, const std::vector<int>& params) {
+  benchmark_btree_sweep<uint32_t, Searcher>(benchmark, pareto, params);
+}
+
+template <int record>
+void benchmark_32_btree(tli::Benchmark<uint32_t>& benchmark, const std::string& filename) {
+  if (filename.find("books_200M") != std::string::npos) {
+    if (filename.find("0.000000i") != std::string::npos) {
+      benchmark.template Run<STXBTree<uint32_t, LinearSearch<record>,6>>();
+      benchmark.template Run<STXBTree<uint32_t, LinearSearch<record>,8>>();
+      benchmark.template Run<STXBTree<uint32_t, InterpolationSearch<record>,16>>();
+    } else if (filename.find("mix") == std::string::npos) {
+      if (filename.find("0m") != std::string::npos) {
+        benchmark.template Run<STXBTree<uint32_t, InterpolationSearch<record>,10>>();
+        benchmark.template Run<STXBTree<uint32_t, LinearSearch<record>,8>>();
+        benchmark.template Run<STXBTree<uint32_t, InterpolationSearch<record>,12>>();
+      } else if (filename.find("1m") != std::string::npos) {
+        benchmark.template Run<STXBTree<uint32_t, InterpolationSearch<record>,18>>();
+        benchmark.template Run<STXBTree<uint32_t, InterpolationSearch<record>,16>>();
+        benchmark.template Run<STXBTree<uint32_t, InterpolationSearch<record>,14>>();
+      } else if (filename.find("2m") != std::string::npos) {
+        benchmark.template Run<STXBTree<uint32_t, LinearSearch<record>,8>>();
+        benchmark.template Run<STXBTree<uint32_t, InterpolationSearch<record>,8>>();
+        benchmark.template Run<STXBTree<uint32_t, LinearAVX<uint32_t, record>,10>>();
+      }
+    } else {
+      if (filename.find("0.050000i") != std::string::npos) {
+        benchmark.template Run<STXBTree<uint32_t, LinearSearch<record>,6>>();
+        benchmark.template Run<STXBTree<uint32_t, LinearSearch<record>,8>>();
+        benchmark.template Run<STXBTree<uint32_t, InterpolationSearch<record>,16>>();
+      } else if (filename.find("0.500000i") != std::string::npos) {
+        benchmark.template Run<STXBTree<uint32_t, LinearSearch<record>,8>>();
+        benchmark.template Run<STXBTree<uint32_t, LinearSearch<record>,6>>();
+        benchmark.template Run<STXBTree<uint32_t, InterpolationSearch<record>,12>>();
+      } else if (filename.find("0.800000i") != std::string::npos) {
+        benchmark.template Run<STXBTree<uint32_t, LinearSearch<record>,8>>();
+        benchmark.template Run<STXBTree<uint32_t, InterpolationSearch<record>,10>>();
+        benchmark.template Run<STXBTree<uint32_t, InterpolationSearch<record>,12>>();
+      }
+    }
+  }
+}
+
 INSTANTIATE_TEMPLATES(benchmark_64_btree, uint64_t);
+
+INSTANTIATE_TEMPLATES(benchmark_32_btree, uint32_t);
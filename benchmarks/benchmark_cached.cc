@@ -0,0 +1,87 @@
+#include "benchmarks/benchmark_cached.h"
+
+#include <string>
+
+#include "benchmark.h"
+#include "benchmarks/common.h"
+#include "competitors/alex.h"
+#include "competitors/art.h"
+#include "competitors/cached.h"
+#include "competitors/pgm_index.h"
+#include "competitors/stx_btree.h"
+
+// Runs Index behind per-thread caches. params are the KiB of cache per
+// thread and the admission, 0 for every miss or 1 for a doorkeeper.
+template <typename KeyType, typename Index>
+void benchmark_cached_index(tli::Benchmark<KeyType>& benchmark, const std::vector<int>& index_params,
+                            bool pareto, const std::vector<int>& params) {
+  auto run = [&](int cache_kib, int admission) {
+    if (cache_kib <= 0 || (admission != 0 && admission != 1)){
+      util::fail("The cache must have a positive size, and admit every miss (0) or use a doorkeeper (1)");
+    }
+    std::vector<int> cached_params = index_params;
+    cached_params.push_back(cache_kib);
+    cached_params.push_back(admission);
+    benchmark.template Run<Cached<KeyType, Index>>(cached_params);
+  };
+  if (!pareto){
+    if (params.size() != 2){
+      util::fail("Cached indexes take the KiB of cache per thread and the admission as params");
+    }
+    run(params[0], params[1]);
+  }
+  else{
+    for (int cache_kib: {16, 64, 256, 1024}){
+      run(cache_kib, 0);
+      run(cache_kib, 1);
+    }
+  }
+}
+
+template <typename KeyType, typename Searcher>
+void benchmark_cached(tli::Benchmark<KeyType>& benchmark, bool pareto, const std::vector<int>& params,
+                      const std::string& index) {
+  if (index == "PGM"){
+    benchmark_cached_index<KeyType, PGM<KeyType, Searcher, 64>>(benchmark, {}, pareto, params);
+  }
+  else if (index == "BTree"){
+    benchmark_cached_index<KeyType, STXBTree<KeyType, Searcher, 8>>(benchmark, {}, pareto, params);
+  }
+  else if (index == "ALEX"){
+    benchmark_cached_index<KeyType, Alex<KeyType, Searcher>>(benchmark, {24}, pareto, params);
+  }
+  else if (index == "ART"){
+    benchmark_cached_index<KeyType, tli_art::ART<KeyType>>(benchmark, {}, pareto, params);
+  }
+  else{
+    util::fail("No cached variant of " + index);
+  }
+}
+
+template <typename Searcher>
+void benchmark_64_cached(tli::Benchmark<uint64_t>& benchmark, 
+                         bool pareto, const std::vector<int>& params, const std::string& index) {
+  benchmark_cached<uint64_t, Searcher>(benchmark, pareto, params, index);
+}
+
+template <int record>
+void benchmark_64_cached(tli::Benchmark<uint64_t>& benchmark, const std::string& index) {
+  benchmark_cached<uint64_t, BranchingBinarySearch<record>>(benchmark, false, {64, 1}, index);
+}
+
+template <typename Searcher>
+void benchmark_32_cached(tli::Benchmark<uint32_t>& benchmark, 
+                         bool pareto, const std::vector<int>& params, const std::string& index) {
+  benchmark_cached<uint32_t, Searcher>(benchmark, pareto, params, index);
+}
+
+template <int record>
+void benchmark_32_cached(tli::Benchmark<uint32_t>& benchmark, const std::string& index) {
+  benchmark_cached<uint32_t, BranchingBinarySearch<record>>(benchmark, false, {64, 1}, index);
+}
+
+INSTANTIATE_TEMPLATES_RMI_(benchmark_64_cached, uint64_t, 0);
+INSTANTIATE_TEMPLATES_RMI_(benchmark_64_cached, uint64_t, 1);
+
+INSTANTIATE_TEMPLATES_RMI_(benchmark_32_cached, uint32_t, 0);
+INSTANTIATE_TEMPLATES_RMI_(benchmark_32_cached, uint32_t, 1);
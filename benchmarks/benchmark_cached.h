@@ -0,0 +1,19 @@
+#pragma once
+#include <string>
+
+#include "benchmark.h"
+
+// `index` is the wrapped index: PGM, BTree, ALEX or ART.
+template <typename Searcher>
+void benchmark_64_cached(tli::Benchmark<uint64_t>& benchmark, 
+                         bool pareto, const std::vector<int>& params, const std::string& index);
+
+template <int record>
+void benchmark_64_cached(tli::Benchmark<uint64_t>& benchmark, const std::string& index);
+
+template <typename Searcher>
+void benchmark_32_cached(tli::Benchmark<uint32_t>& benchmark, 
+                         bool pareto, const std::vector<int>& params, const std::string& index);
+
+template <int record>
+void benchmark_32_cached(tli::Benchmark<uint32_t>& benchmark, const std::string& index);
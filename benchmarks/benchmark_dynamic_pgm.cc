@@ -4,23 +4,31 @@
 #include "benchmarks/common.h"
 #include "competitors/dynamic_pgm_index.h"
 
-template <typename Searcher>
-void benchmark_64_dynamic_pgm(tli::Benchmark<uint64_t>& benchmark, 
-                              bool pareto, const std::vector<int>& params) {
+// Errors of Dynamic PGM.
+typedef ParamValues<16, 32, 64, 128, 256, 512, 1024> dynamic_pgm_values;
+
+template <typename KeyType, typename Searcher>
+void benchmark_dynamic_pgm_sweep(tli::Benchmark<KeyType>& benchmark,
+                                 bool pareto, const std::vector<int>& params) {
+  auto run = [&](auto value) {
+    benchmark.template Run<DynamicPGM<KeyType, Searcher, decltype(value)::value>>();
+  };
   if (!pareto){
-    util::fail("Dynamic PGM's hyperparameter cannot be set");
+    if (params.size() != 1 || !dynamic_pgm_values::Dispatch(params[0], run)){
+      util::fail("Dynamic PGM's error must be one of " + dynamic_pgm_values::Names());
+    }
   }
   else{
-    benchmark.template Run<DynamicPGM<uint64_t, Searcher, 16>>();
-    benchmark.template Run<DynamicPGM<uint64_t, Searcher, 32>>();
-    benchmark.template Run<DynamicPGM<uint64_t, Searcher, 64>>();
-    benchmark.template Run<DynamicPGM<uint64_t, Searcher, 128>>();
-    benchmark.template Run<DynamicPGM<uint64_t, Searcher, 256>>();
-    benchmark.template Run<DynamicPGM<uint64_t, Searcher, 512>>();
-    benchmark.template Run<DynamicPGM<uint64_t, Searcher, 1024>>();
+    dynamic_pgm_values::ForEach(run);
   }
 }
 
+template <typename Searcher>
+void benchmark_64_dynamic_pgm(tli::Benchmark<uint64_t>& benchmark, 
+                              bool pareto, const std::vector<int>& params) {
+  benchmark_dynamic_pgm_sweep<uint64_t, Searcher>(benchmark, pareto, params);
+}
+
 template <int record>
 void benchmark_64_dynamic_pgm(tli::Benchmark<uint64_t>& benchmark, const std::string& filename) {
   if (filename.find("books_200M") != std::string::npos) {
@@ -165,4 +173,51 @@ void benchmark_64_dynamic_pgm(tli::Benchmark<uint64_t>& benchmark, const std::st
   }
 }
 
-INSTANTIATE_TEMPLATES(benchmark_64_dynamic_pgm, uint64_t);
\ No newline at end of file
+template <typename Searcher>
+void benchmark_32_dynamic_pgm(tli::Benchmark<uint32_t>& benchmark, 
+                              bool pareto, const std::vector<int>& params) {
+  benchmark_dynamic_pgm_sweep<uint32_t, Searcher>(benchmark, pareto, params);
+}
+
+template <int record>
+void benchmark_32_dynamic_pgm(tli::Benchmark<uint32_t>& benchmark, const std::string& filename) {
+  if (filename.find("books_200M") != std::string::npos) {
+    if (filename.find("0.000000i") != std::string::npos) {
+      benchmark.template Run<DynamicPGM<uint32_t, BranchingBinarySearch<record>,16>>();
+      benchmark.template Run<DynamicPGM<uint32_t, LinearSearch<record>,16>>();
+      benchmark.template Run<DynamicPGM<uint32_t, BranchingBinarySearch<record>,32>>();
+    } else if (filename.find("mix") == std::string::npos) {
+      if (filename.find("0m") != std::string::npos) {
+        benchmark.template Run<DynamicPGM<uint32_t, InterpolationSearch<record>,256>>();
+        benchmark.template Run<DynamicPGM<uint32_t, InterpolationSearch<record>,128>>();
+        benchmark.template Run<DynamicPGM<uint32_t, InterpolationSearch<record>,512>>();
+      } else if (filename.find("1m") != std::string::npos) {
+        benchmark.template Run<DynamicPGM<uint32_t, InterpolationSearch<record>,512>>();
+        benchmark.template Run<DynamicPGM<uint32_t, ExponentialSearch<record>,256>>();
+        benchmark.template Run<DynamicPGM<uint32_t, ExponentialSearch<record>,512>>();
+      } else if (filename.find("2m") != std::string::npos) {
+        benchmark.template Run<DynamicPGM<uint32_t, InterpolationSearch<record>,512>>();
+        benchmark.template Run<DynamicPGM<uint32_t, ExponentialSearch<record>,512>>();
+        benchmark.template Run<DynamicPGM<uint32_t, LinearSearch<record>,256>>();
+      }
+    } else {
+      if (filename.find("0.050000i") != std::string::npos) {
+        benchmark.template Run<DynamicPGM<uint32_t, BranchingBinarySearch<record>,16>>();
+        benchmark.template Run<DynamicPGM<uint32_t, BranchingBinarySearch<record>,32>>();
+        benchmark.template Run<DynamicPGM<uint32_t, LinearSearch<record>,16>>();
+      } else if (filename.find("0.500000i") != std::string::npos) {
+        benchmark.template Run<DynamicPGM<uint32_t, LinearSearch<record>,32>>();
+        benchmark.template Run<DynamicPGM<uint32_t, BranchingBinarySearch<record>,32>>();
+        benchmark.template Run<DynamicPGM<uint32_t, BranchingBinarySearch<record>,16>>();
+      } else if (filename.find("0.800000i") != std::string::npos) {
+        benchmark.template Run<DynamicPGM<uint32_t, LinearSearch<record>,32>>();
+        benchmark.template Run<DynamicPGM<uint32_t, InterpolationSearch<record>,128>>();
+        benchmark.template Run<DynamicPGM<uint32_t, InterpolationSearch<record>,256>>();
+      }
+    }
+  }
+}
+
+INSTANTIATE_TEMPLATES(benchmark_64_dynamic_pgm, uint64_t);
+
+INSTANTIATE_TEMPLATES(benchmark_32_dynamic_pgm, uint32_t);
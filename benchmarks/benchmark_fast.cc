@@ -7,3 +7,7 @@
 void benchmark_64_fast(tli::Benchmark<uint64_t>& benchmark) {
   benchmark.template Run<Fast<uint64_t>>();
 }
+
+void benchmark_32_fast(tli::Benchmark<uint32_t>& benchmark) {
+  benchmark.template Run<Fast<uint32_t>>();
+}
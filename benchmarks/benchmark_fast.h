@@ -2,3 +2,5 @@
 #include "benchmark.h"
 
 void benchmark_64_fast(tli::Benchmark<uint64_t>& benchmark);
+
+void benchmark_32_fast(tli::Benchmark<uint32_t>& benchmark);
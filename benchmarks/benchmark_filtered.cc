@@ -0,0 +1,99 @@
+#include "benchmarks/benchmark_filtered.h"
+
+#include <string>
+
+#include "benchmark.h"
+#include "benchmarks/common.h"
+#include "competitors/alex.h"
+#include "competitors/art.h"
+#include "competitors/filtered.h"
+#include "competitors/pgm_index.h"
+#include "competitors/stx_btree.h"
+
+// Runs Index behind a filter. params are the filter, 0 for a Bloom filter or
+// the tag bits of a cuckoo filter, then its bits per key.
+template <typename KeyType, typename Index>
+void benchmark_filtered_index(tli::Benchmark<KeyType>& benchmark, const std::vector<int>& index_params,
+                              bool pareto, const std::vector<int>& params) {
+  auto run = [&](int filter, int bits_per_key) {
+    std::vector<int> filtered_params = index_params;
+    filtered_params.push_back(bits_per_key);
+    switch (filter) {
+      case 0:
+        benchmark.template Run<Filtered<KeyType, Index, BloomFilter>>(filtered_params);
+        break;
+      case 8:
+        benchmark.template Run<Filtered<KeyType, Index, CuckooFilter<8>>>(filtered_params);
+        break;
+      case 16:
+        benchmark.template Run<Filtered<KeyType, Index, CuckooFilter<16>>>(filtered_params);
+        break;
+      default:
+        util::fail("The filter must be 0 for Bloom, or 8 or 16 for the tag bits of a cuckoo filter");
+    }
+  };
+  if (!pareto){
+    if (params.size() != 2 || params[1] <= 0){
+      util::fail("Filtered indexes take the filter and its bits per key as params");
+    }
+    run(params[0], params[1]);
+  }
+  else{
+    // Blocks of cuckoo filters overflow unless they are about half full.
+    for (int bits_per_key: {8, 12, 16}){
+      run(0, bits_per_key);
+    }
+    run(8, 12);
+    run(8, 16);
+    run(16, 24);
+    run(16, 32);
+  }
+}
+
+template <typename KeyType, typename Searcher>
+void benchmark_filtered(tli::Benchmark<KeyType>& benchmark, bool pareto, const std::vector<int>& params,
+                        const std::string& index) {
+  if (index == "PGM"){
+    benchmark_filtered_index<KeyType, PGM<KeyType, Searcher, 64>>(benchmark, {}, pareto, params);
+  }
+  else if (index == "BTree"){
+    benchmark_filtered_index<KeyType, STXBTree<KeyType, Searcher, 8>>(benchmark, {}, pareto, params);
+  }
+  else if (index == "ALEX"){
+    benchmark_filtered_index<KeyType, Alex<KeyType, Searcher>>(benchmark, {24}, pareto, params);
+  }
+  else if (index == "ART"){
+    benchmark_filtered_index<KeyType, tli_art::ART<KeyType>>(benchmark, {}, pareto, params);
+  }
+  else{
+    util::fail("No filtered variant of " + index);
+  }
+}
+
+template <typename Searcher>
+void benchmark_64_filtered(tli::Benchmark<uint64_t>& benchmark, 
+                           bool pareto, const std::vector<int>& params, const std::string& index) {
+  benchmark_filtered<uint64_t, Searcher>(benchmark, pareto, params, index);
+}
+
+template <int record>
+void benchmark_64_filtered(tli::Benchmark<uint64_t>& benchmark, const std::string& index) {
+  benchmark_filtered<uint64_t, BranchingBinarySearch<record>>(benchmark, false, {0, 10}, index);
+}
+
+template <typename Searcher>
+void benchmark_32_filtered(tli::Benchmark<uint32_t>& benchmark, 
+                           bool pareto, const std::vector<int>& params, const std::string& index) {
+  benchmark_filtered<uint32_t, Searcher>(benchmark, pareto, params, index);
+}
+
+template <int record>
+void benchmark_32_filtered(tli::Benchmark<uint32_t>& benchmark, const std::string& index) {
+  benchmark_filtered<uint32_t, BranchingBinarySearch<record>>(benchmark, false, {0, 10}, index);
+}
+
+INSTANTIATE_TEMPLATES_RMI_(benchmark_64_filtered, uint64_t, 0);
+INSTANTIATE_TEMPLATES_RMI_(benchmark_64_filtered, uint64_t, 1);
+
+INSTANTIATE_TEMPLATES_RMI_(benchmark_32_filtered, uint32_t, 0);
+INSTANTIATE_TEMPLATES_RMI_(benchmark_32_filtered, uint32_t, 1);
@@ -132,6 +132,68 @@ void benchmark_64_finedex(tli::Benchmark<uint64_t>& benchmark, const std::string
   }
 }
 
+template <typename Searcher>
+void benchmark_32_finedex(tli::Benchmark<uint32_t>& benchmark, bool pareto, 
+                          const std::vector<int>& params, const std::string& filename) {
+  if (!pareto){
+    benchmark.template Run<tli_finedex::FINEdex<uint32_t, Searcher>>(params);
+  }
+  else {
+    benchmark.template Run<tli_finedex::FINEdex<uint32_t, Searcher>>({32});
+    benchmark.template Run<tli_finedex::FINEdex<uint32_t, Searcher>>({64});
+    benchmark.template Run<tli_finedex::FINEdex<uint32_t, Searcher>>({128});
+    benchmark.template Run<tli_finedex::FINEdex<uint32_t, Searcher>>({256});
+    benchmark.template Run<tli_finedex::FINEdex<uint32_t, Searcher>>({512});
+    if (filename.find("books_200M") == std::string::npos) {
+      benchmark.template Run<tli_finedex::FINEdex<uint32_t, Searcher>>({1024});
+      benchmark.template Run<tli_finedex::FINEdex<uint32_t, Searcher>>({2048});
+    }
+  }
+}
+
+template <int record>
+void benchmark_32_finedex(tli::Benchmark<uint32_t>& benchmark, const std::string& filename) {
+  if (filename.find("books_200M") != std::string::npos) {
+    if (filename.find("0.000000i") != std::string::npos) {
+      benchmark.template Run<tli_finedex::FINEdex<uint32_t, InterpolationSearch<record>>>({256});
+      benchmark.template Run<tli_finedex::FINEdex<uint32_t, InterpolationSearch<record>>>({128});
+      benchmark.template Run<tli_finedex::FINEdex<uint32_t, LinearAVX<uint32_t, record>>>({64});
+    } else if (filename.find("mix") == std::string::npos) {
+      if (filename.find("0m") != std::string::npos) {
+        benchmark.template Run<tli_finedex::FINEdex<uint32_t, LinearAVX<uint32_t, record>>>({64});
+        benchmark.template Run<tli_finedex::FINEdex<uint32_t, InterpolationSearch<record>>>({128});
+        benchmark.template Run<tli_finedex::FINEdex<uint32_t, BranchingBinarySearch<record>>>({64});
+      } else if (filename.find("1m") != std::string::npos) {
+        benchmark.template Run<tli_finedex::FINEdex<uint32_t, InterpolationSearch<record>>>({512});
+        benchmark.template Run<tli_finedex::FINEdex<uint32_t, LinearSearch<record>>>({256});
+        benchmark.template Run<tli_finedex::FINEdex<uint32_t, LinearSearch<record>>>({512});
+      } else if (filename.find("2m") != std::string::npos) {
+        benchmark.template Run<tli_finedex::FINEdex<uint32_t, LinearSearch<record>>>({64});
+        benchmark.template Run<tli_finedex::FINEdex<uint32_t, BranchingBinarySearch<record>>>({128});
+        benchmark.template Run<tli_finedex::FINEdex<uint32_t, InterpolationSearch<record>>>({512});
+      }
+    } else {
+      if (filename.find("0.050000i") != std::string::npos) {
+        benchmark.template Run<tli_finedex::FINEdex<uint32_t, InterpolationSearch<record>>>({256});
+        benchmark.template Run<tli_finedex::FINEdex<uint32_t, InterpolationSearch<record>>>({128});
+        benchmark.template Run<tli_finedex::FINEdex<uint32_t, LinearAVX<uint32_t, record>>>({64});
+      } else if (filename.find("0.500000i") != std::string::npos) {
+        benchmark.template Run<tli_finedex::FINEdex<uint32_t, InterpolationSearch<record>>>({128});
+        benchmark.template Run<tli_finedex::FINEdex<uint32_t, LinearAVX<uint32_t, record>>>({64});
+        benchmark.template Run<tli_finedex::FINEdex<uint32_t, InterpolationSearch<record>>>({64});
+      } else if (filename.find("0.800000i") != std::string::npos) {
+        benchmark.template Run<tli_finedex::FINEdex<uint32_t, LinearAVX<uint32_t, record>>>({64});
+        benchmark.template Run<tli_finedex::FINEdex<uint32_t, InterpolationSearch<record>>>({128});
+        benchmark.template Run<tli_finedex::FINEdex<uint32_t, InterpolationSearch<record>>>({64});
+      }
+    }
+  }
+}
+
 INSTANTIATE_TEMPLATES_RMI_(benchmark_64_finedex, uint64_t, 0);
 INSTANTIATE_TEMPLATES_RMI_(benchmark_64_finedex, uint64_t, 1);
-INSTANTIATE_TEMPLATES_RMI_(benchmark_64_finedex, uint64_t, 2);
\ No newline at end of file
+INSTANTIATE_TEMPLATES_RMI_(benchmark_64_finedex, uint64_t, 2);
+
+INSTANTIATE_TEMPLATES_RMI_(benchmark_32_finedex, uint32_t, 0);
+INSTANTIATE_TEMPLATES_RMI_(benchmark_32_finedex, uint32_t, 1);
+INSTANTIATE_TEMPLATES_RMI_(benchmark_32_finedex, uint32_t, 2);
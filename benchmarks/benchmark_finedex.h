@@ -6,3 +6,9 @@ void benchmark_64_finedex(tli::Benchmark<uint64_t>& benchmark, bool pareto, cons
 
 template <int record>
 void benchmark_64_finedex(tli::Benchmark<uint64_t>& benchmark, const std::string& filename);
+
+template <typename Searcher>
+void benchmark_32_finedex(tli::Benchmark<uint32_t>& benchmark, bool pareto, const std::vector<int>& params, const std::string& filename);
+
+template <int record>
+void benchmark_32_finedex(tli::Benchmark<uint32_t>& benchmark, const std::string& filename);
@@ -7,3 +7,7 @@
 void benchmark_64_lipp(tli::Benchmark<uint64_t>& benchmark) {
   benchmark.template Run<Lipp<uint64_t>>();
 }
+
+void benchmark_32_lipp(tli::Benchmark<uint32_t>& benchmark) {
+  benchmark.template Run<Lipp<uint32_t>>();
+}
@@ -2,3 +2,5 @@
 #include "benchmark.h"
 
 void benchmark_64_lipp(tli::Benchmark<uint64_t>& benchmark);
+
+void benchmark_32_lipp(tli::Benchmark<uint32_t>& benchmark);
@@ -3,31 +3,39 @@
 #include "common.h"
 #include "competitors/mabtree.h"
 
-template <typename Searcher>
-void benchmark_64_mabtree(tli::Benchmark<uint64_t>& benchmark, 
-                          bool pareto, const std::vector<int>& params) {
+// Log2 of the node sizes and of the prediction page sizes of MAB+tree.
+typedef ParamValues<10, 12, 14, 16, 18> mabtree_node_values;
+typedef ParamValues<6, 7, 8> mabtree_page_values;
+
+template <typename KeyType, typename Searcher>
+void benchmark_mabtree_sweep(tli::Benchmark<KeyType>& benchmark,
+                             bool pareto, const std::vector<int>& params) {
+  auto run = [&](auto node, auto page) {
+    benchmark.template Run<MABTree<KeyType, Searcher, decltype(node)::value, decltype(page)::value>>();
+  };
   if (!pareto){
-    util::fail("MAB+tree's hyperparameters cannot be set");
+    bool found = params.size() == 2 && mabtree_node_values::Dispatch(params[0], [&](auto node) {
+      if (!mabtree_page_values::Dispatch(params[1], [&](auto page) { run(node, page); })){
+        util::fail("MAB+tree's page size log must be one of " + mabtree_page_values::Names());
+      }
+    });
+    if (!found){
+      util::fail("MAB+tree's node size log must be one of " + mabtree_node_values::Names());
+    }
   }
-  else {
-    benchmark.template Run<MABTree<uint64_t, Searcher, 10, 6>>();
-    benchmark.template Run<MABTree<uint64_t, Searcher, 10, 7>>();
-    benchmark.template Run<MABTree<uint64_t, Searcher, 10, 8>>();
-    benchmark.template Run<MABTree<uint64_t, Searcher, 12, 6>>();
-    benchmark.template Run<MABTree<uint64_t, Searcher, 12, 7>>();
-    benchmark.template Run<MABTree<uint64_t, Searcher, 12, 8>>();
-    benchmark.template Run<MABTree<uint64_t, Searcher, 14, 6>>();
-    benchmark.template Run<MABTree<uint64_t, Searcher, 14, 7>>();
-    benchmark.template Run<MABTree<uint64_t, Searcher, 14, 8>>();
-    benchmark.template Run<MABTree<uint64_t, Searcher, 16, 6>>();
-    benchmark.template Run<MABTree<uint64_t, Searcher, 16, 7>>();
-    benchmark.template Run<MABTree<uint64_t, Searcher, 16, 8>>();
-    benchmark.template Run<MABTree<uint64_t, Searcher, 18, 6>>();
-    benchmark.template Run<MABTree<uint64_t, Searcher, 18, 7>>();
-    benchmark.template Run<MABTree<uint64_t, Searcher, 18, 8>>();
+  else{
+    mabtree_node_values::ForEach([&](auto node) {
+      mabtree_page_values::ForEach([&](auto page) { run(node, page); });
+    });
   }
 }
 
+template <typename Searcher>
+void benchmark_64_mabtree(tli::Benchmark<uint64_t>& benchmark, 
+                          bool pareto, const std::vector<int>& params) {
+  benchmark_mabtree_sweep<uint64_t, Searcher>(benchmark, pareto, params);
+}
+
 template <int record>
 void benchmark_64_mabtree(tli::Benchmark<uint64_t>& benchmark, const std::string& filename) {
   if (filename.find("books_200M") != std::string::npos) {
@@ -172,4 +180,51 @@ void benchmark_64_mabtree(tli::Benchmark<uint64_t>& benchmark, const std::string
   }
 }
 
+template <typename Searcher>
+void benchmark_32_mabtree(tli::Benchmark<uint32_t>& benchmark, 
+                          bool pareto, const std::vector<int>& params) {
+  benchmark_mabtree_sweep<uint32_t, Searcher>(benchmark, pareto, params);
+}
+
+template <int record>
+void benchmark_32_mabtree(tli::Benchmark<uint32_t>& benchmark, const std::string& filename) {
+  if (filename.find("books_200M") != std::string::npos) {
+    if (filename.find("0.000000i") != std::string::npos) {
+      benchmark.template Run<MABTree<uint32_t, LinearSearch<record>,12,7>>();
+      benchmark.template Run<MABTree<uint32_t, LinearSearch<record>,12,6>>();
+      benchmark.template Run<MABTree<uint32_t, LinearSearch<record>,12,8>>();
+    } else if (filename.find("mix") == std::string::npos) {
+      if (filename.find("0m") != std::string::npos) {
+        benchmark.template Run<MABTree<uint32_t, LinearSearch<record>,12,7>>();
+        benchmark.template Run<MABTree<uint32_t, LinearSearch<record>,10,7>>();
+        benchmark.template Run<MABTree<uint32_t, LinearSearch<record>,12,6>>();
+      } else if (filename.find("1m") != std::string::npos) {
+        benchmark.template Run<MABTree<uint32_t, LinearSearch<record>,18,6>>();
+        benchmark.template Run<MABTree<uint32_t, LinearSearch<record>,16,7>>();
+        benchmark.template Run<MABTree<uint32_t, LinearSearch<record>,16,6>>();
+      } else if (filename.find("2m") != std::string::npos) {
+        benchmark.template Run<MABTree<uint32_t, LinearSearch<record>,10,7>>();
+        benchmark.template Run<MABTree<uint32_t, LinearSearch<record>,10,8>>();
+        benchmark.template Run<MABTree<uint32_t, LinearAVX<uint32_t, record>,12,8>>();
+      }
+    } else {
+      if (filename.find("0.050000i") != std::string::npos) {
+        benchmark.template Run<MABTree<uint32_t, LinearSearch<record>,12,7>>();
+        benchmark.template Run<MABTree<uint32_t, LinearSearch<record>,12,6>>();
+        benchmark.template Run<MABTree<uint32_t, LinearSearch<record>,12,8>>();
+      } else if (filename.find("0.500000i") != std::string::npos) {
+        benchmark.template Run<MABTree<uint32_t, LinearSearch<record>,12,7>>();
+        benchmark.template Run<MABTree<uint32_t, LinearSearch<record>,12,6>>();
+        benchmark.template Run<MABTree<uint32_t, LinearSearch<record>,10,7>>();
+      } else if (filename.find("0.800000i") != std::string::npos) {
+        benchmark.template Run<MABTree<uint32_t, LinearSearch<record>,12,7>>();
+        benchmark.template Run<MABTree<uint32_t, LinearSearch<record>,12,6>>();
+        benchmark.template Run<MABTree<uint32_t, LinearSearch<record>,10,7>>();
+      }
+    }
+  }
+}
+
 INSTANTIATE_TEMPLATES(benchmark_64_mabtree, uint64_t);
+
+INSTANTIATE_TEMPLATES(benchmark_32_mabtree, uint32_t);
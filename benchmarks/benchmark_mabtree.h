@@ -7,3 +7,10 @@ void benchmark_64_mabtree(tli::Benchmark<uint64_t>& benchmark,
 
 template <int record>
 void benchmark_64_mabtree(tli::Benchmark<uint64_t>& benchmark, const std::string& filename);
+
+template <typename Searcher>
+void benchmark_32_mabtree(tli::Benchmark<uint32_t>& benchmark, 
+                          bool pareto, const std::vector<int>& params);
+
+template <int record>
+void benchmark_32_mabtree(tli::Benchmark<uint32_t>& benchmark, const std::string& filename);
@@ -4,23 +4,31 @@
 #include "benchmarks/common.h"
 #include "competitors/pgm_index.h"
 
-template <typename Searcher>
-void benchmark_64_pgm(tli::Benchmark<uint64_t>& benchmark, 
-                      bool pareto, const std::vector<int>& params) {
+// Errors of PGM.
+typedef ParamValues<4, 8, 16, 32, 64, 128, 256> pgm_values;
+
+template <typename KeyType, typename Searcher>
+void benchmark_pgm_sweep(tli::Benchmark<KeyType>& benchmark,
+                         bool pareto, const std::vector<int>& params) {
+  auto run = [&](auto value) {
+    benchmark.template Run<PGM<KeyType, Searcher, decltype(value)::value>>();
+  };
   if (!pareto){
-    util::fail("PGM's hyperparameter cannot be set");
+    if (params.size() != 1 || !pgm_values::Dispatch(params[0], run)){
+      util::fail("PGM's error must be one of " + pgm_values::Names());
+    }
   }
-  else {
-    benchmark.template Run<PGM<uint64_t, Searcher, 4>>();
-    benchmark.template Run<PGM<uint64_t, Searcher, 8>>();
-    benchmark.template Run<PGM<uint64_t, Searcher, 16>>();
-    benchmark.template Run<PGM<uint64_t, Searcher, 32>>();
-    benchmark.template Run<PGM<uint64_t, Searcher, 64>>();
-    benchmark.template Run<PGM<uint64_t, Searcher, 128>>();
-    benchmark.template Run<PGM<uint64_t, Searcher, 256>>();
+  else{
+    pgm_values::ForEach(run);
   }
 }
 
+template <typename Searcher>
+void benchmark_64_pgm(tli::Benchmark<uint64_t>& benchmark, 
+                      bool pareto, const std::vector<int>& params) {
+  benchmark_pgm_sweep<uint64_t, Searcher>(benchmark, pareto, params);
+}
+
 template <int record>
 void benchmark_64_pgm(tli::Benchmark<uint64_t>& benchmark, const std::string& filename) {
   if (filename.find("books_200M") != std::string::npos) {
@@ -45,4 +53,21 @@ void benchmark_64_pgm(tli::Benchmark<uint64_t>& benchmark, const std::string& fi
   }
 }
 
-INSTANTIATE_TEMPLATES(benchmark_64_pgm, uint64_t);
\ No newline at end of file
+template <typename Searcher>
+void benchmark_32_pgm(tli::Benchmark<uint32_t>& benchmark, 
+                      bool pareto, const std::vector<int>& params) {
+  benchmark_pgm_sweep<uint32_t, Searcher>(benchmark, pareto, params);
+}
+
+template <int record>
+void benchmark_32_pgm(tli::Benchmark<uint32_t>& benchmark, const std::string& filename) {
+  if (filename.find("books_200M") != std::string::npos) {
+    benchmark.template Run<PGM<uint32_t, LinearSearch<record>,32>>();
+    benchmark.template Run<PGM<uint32_t, BranchingBinarySearch<record>,64>>();
+    benchmark.template Run<PGM<uint32_t, BranchingBinarySearch<record>,256>>();
+  }
+}
+
+INSTANTIATE_TEMPLATES(benchmark_64_pgm, uint64_t);
+
+INSTANTIATE_TEMPLATES(benchmark_32_pgm, uint32_t);
@@ -96,5 +96,35 @@ void benchmark_64_rmi(tli::Benchmark<uint64_t>& benchmark, const std::string& fi
   }
 }
 
+template <typename Searcher>
+void benchmark_32_rmi(tli::Benchmark<uint32_t>& benchmark, 
+                      bool pareto, const std::vector<int>& params, const std::string& filename) {
+  if (!pareto){
+    util::fail("RMI's hyperparameters cannot be set");
+  }
+  else {
+    run_rmi_pareto(uint32, books_200M, Searcher);
+
+    // run_rmi_pareto(uint32, uniform_dense_200M, Searcher);
+    // run_rmi_pareto(uint32, uniform_sparse_200M, Searcher);
+    // run_rmi_pareto(uint32, lognormal_200M, Searcher);
+    // run_rmi_pareto(uint32, normal_200M, Searcher);
+  }
+}
+
+template <int record>
+void benchmark_32_rmi(tli::Benchmark<uint32_t>& benchmark, const std::string& filename) {
+  if (filename.find("bulkload") == std::string::npos) {
+    if (filename.find("books_200M") != std::string::npos) {
+      run_rmi(uint32, books_200M, LinearSearch<record>, 0, 0);
+      run_rmi(uint32, books_200M, LinearSearch<record>, 1, 1);
+      run_rmi(uint32, books_200M, LinearSearch<record>, 2, 2);
+    }
+  }
+}
+
 INSTANTIATE_TEMPLATES_RMI_(benchmark_64_rmi, uint64_t, 0);
 INSTANTIATE_TEMPLATES_RMI_(benchmark_64_rmi, uint64_t, 1);
+
+INSTANTIATE_TEMPLATES_RMI_(benchmark_32_rmi, uint32_t, 0);
+INSTANTIATE_TEMPLATES_RMI_(benchmark_32_rmi, uint32_t, 1);
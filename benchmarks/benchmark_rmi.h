@@ -9,3 +9,10 @@ void benchmark_64_rmi(tli::Benchmark<uint64_t>& benchmark,
 
 template <int record>
 void benchmark_64_rmi(tli::Benchmark<uint64_t>& benchmark, const std::string& filename);
+
+template <typename Searcher>
+void benchmark_32_rmi(tli::Benchmark<uint32_t>& benchmark, 
+                      bool pareto, const std::vector<int>& params, const std::string& filename);
+
+template <int record>
+void benchmark_32_rmi(tli::Benchmark<uint32_t>& benchmark, const std::string& filename);
@@ -0,0 +1,61 @@
+#include "benchmarks/benchmark_rmi_native.h"
+
+#include "benchmark.h"
+#include "benchmarks/common.h"
+#include "competitors/rmi_native.h"
+
+// Root types: 0 linear, 1 cubic, 2 radix, 3 linear spline.
+template <typename KeyType, typename Searcher>
+void benchmark_rmi_native_pareto(tli::Benchmark<KeyType>& benchmark) {
+  for (int root_type = 0; root_type < 4; ++root_type) {
+    benchmark.template Run<RMINative<KeyType, Searcher>>({root_type, 10});
+    benchmark.template Run<RMINative<KeyType, Searcher>>({root_type, 14});
+    benchmark.template Run<RMINative<KeyType, Searcher>>({root_type, 18});
+    benchmark.template Run<RMINative<KeyType, Searcher>>({root_type, 22});
+  }
+}
+
+// The models are trained on the loaded keys, so the defaults do not depend
+// on the dataset.
+template <typename KeyType, int record>
+void benchmark_rmi_native_default(tli::Benchmark<KeyType>& benchmark) {
+  benchmark.template Run<RMINative<KeyType, BranchingBinarySearch<record>>>({3, 20});
+  benchmark.template Run<RMINative<KeyType, BranchingBinarySearch<record>>>({1, 20});
+  benchmark.template Run<RMINative<KeyType, LinearSearch<record>>>({2, 22});
+}
+
+template <typename Searcher>
+void benchmark_64_rmi_native(tli::Benchmark<uint64_t>& benchmark, 
+                             bool pareto, const std::vector<int>& params) {
+  if (!pareto){
+    benchmark.template Run<RMINative<uint64_t, Searcher>>(params);
+  }
+  else {
+    benchmark_rmi_native_pareto<uint64_t, Searcher>(benchmark);
+  }
+}
+
+template <int record>
+void benchmark_64_rmi_native(tli::Benchmark<uint64_t>& benchmark, const std::string& filename) {
+  benchmark_rmi_native_default<uint64_t, record>(benchmark);
+}
+
+template <typename Searcher>
+void benchmark_32_rmi_native(tli::Benchmark<uint32_t>& benchmark, 
+                             bool pareto, const std::vector<int>& params) {
+  if (!pareto){
+    benchmark.template Run<RMINative<uint32_t, Searcher>>(params);
+  }
+  else {
+    benchmark_rmi_native_pareto<uint32_t, Searcher>(benchmark);
+  }
+}
+
+template <int record>
+void benchmark_32_rmi_native(tli::Benchmark<uint32_t>& benchmark, const std::string& filename) {
+  benchmark_rmi_native_default<uint32_t, record>(benchmark);
+}
+
+INSTANTIATE_TEMPLATES(benchmark_64_rmi_native, uint64_t);
+
+INSTANTIATE_TEMPLATES(benchmark_32_rmi_native, uint32_t);
@@ -0,0 +1,16 @@
+#pragma once
+#include "benchmark.h"
+
+template <typename Searcher>
+void benchmark_64_rmi_native(tli::Benchmark<uint64_t>& benchmark, 
+                             bool pareto, const std::vector<int>& params);
+
+template <int record>
+void benchmark_64_rmi_native(tli::Benchmark<uint64_t>& benchmark, const std::string& filename);
+
+template <typename Searcher>
+void benchmark_32_rmi_native(tli::Benchmark<uint32_t>& benchmark, 
+                             bool pareto, const std::vector<int>& params);
+
+template <int record>
+void benchmark_32_rmi_native(tli::Benchmark<uint32_t>& benchmark, const std::string& filename);
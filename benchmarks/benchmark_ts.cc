@@ -45,4 +45,32 @@ void benchmark_64_ts(tli::Benchmark<uint64_t>& benchmark, const std::string& fil
   }
 }
 
+template <typename Searcher>
+void benchmark_32_ts(tli::Benchmark<uint32_t>& benchmark, 
+                     bool pareto, const std::vector<int>& params) {
+  if (!pareto){
+    benchmark.template Run<TS<uint32_t, Searcher>>(params);
+  }
+  else {
+    benchmark.template Run<TS<uint32_t, Searcher>>({8});
+    benchmark.template Run<TS<uint32_t, Searcher>>({16});
+    benchmark.template Run<TS<uint32_t, Searcher>>({32});
+    benchmark.template Run<TS<uint32_t, Searcher>>({64});
+    benchmark.template Run<TS<uint32_t, Searcher>>({128});
+    benchmark.template Run<TS<uint32_t, Searcher>>({256});
+    benchmark.template Run<TS<uint32_t, Searcher>>({512});
+  }
+}
+
+template <int record>
+void benchmark_32_ts(tli::Benchmark<uint32_t>& benchmark, const std::string& filename) {
+  if (filename.find("books_200M") != std::string::npos) {
+    benchmark.template Run<TS<uint32_t, LinearSearch<record>>>({8});
+    benchmark.template Run<TS<uint32_t, LinearSearch<record>>>({16});
+    benchmark.template Run<TS<uint32_t, BranchingBinarySearch<record>>>({16});
+  }
+}
+
 INSTANTIATE_TEMPLATES(benchmark_64_ts, uint64_t);
+
+INSTANTIATE_TEMPLATES(benchmark_32_ts, uint32_t);
@@ -11,3 +11,7 @@ void benchmark_string_wormhole(tli::Benchmark<std::string>& benchmark) {
 void benchmark_64_wormhole(tli::Benchmark<uint64_t>& benchmark){
   benchmark.template Run<Wormhole<uint64_t>>();                          
 }
+
+void benchmark_32_wormhole(tli::Benchmark<uint32_t>& benchmark){
+  benchmark.template Run<Wormhole<uint32_t>>();                          
+}
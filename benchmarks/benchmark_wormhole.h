@@ -4,3 +4,5 @@
 void benchmark_string_wormhole(tli::Benchmark<std::string>& benchmark);
 
 void benchmark_64_wormhole(tli::Benchmark<uint64_t>& benchmark);
+
+void benchmark_32_wormhole(tli::Benchmark<uint32_t>& benchmark);
@@ -3,6 +3,34 @@
 #include "searches/exponential_search.h"
 #include "searches/linear_search_avx.h"
 
+#include <string>
+#include <type_traits>
+
+// Values of an integral hyper-parameter that are instantiated for an index.
+// --pareto sweeps all of them, and --params picks one of them at runtime, so
+// that both reach the same template instantiations.
+template <size_t... values>
+struct ParamValues {
+  // Calls fn(std::integral_constant<size_t, v>()) for every value v.
+  template <typename Fn>
+  static void ForEach(Fn&& fn) {
+    (fn(std::integral_constant<size_t, values>()), ...);
+  }
+
+  // Calls fn(std::integral_constant<size_t, value>()).
+  // Returns false if value is not instantiated.
+  template <typename Fn>
+  static bool Dispatch(size_t value, Fn&& fn) {
+    return ((value == values && (fn(std::integral_constant<size_t, values>()), true)) || ...);
+  }
+
+  static std::string Names() {
+    std::string names;
+    ((names += (names.empty() ? "" : ", ") + std::to_string(values)), ...);
+    return names;
+  }
+};
+
 #ifdef FAST_MODE
 #define INSTANTIATE_TEMPLATES_(func_name, type_name, track_errors)                              \
   template void func_name<BranchingBinarySearch<track_errors>>(                                 \
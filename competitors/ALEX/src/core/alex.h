@@ -30,9 +30,11 @@
 
 #pragma once
 
+#include <atomic>
 #include <fstream>
 #include <iostream>
 #include <stack>
+#include <thread>
 #include <type_traits>
 
 #include "alex_base.h"
@@ -95,6 +97,10 @@ class Alex {
     // Approximate cost computation: bulk load faster by using sampling to
     // compute cost
     bool approximate_cost_computation = false;
+    // Count lookups in the stats and the data nodes, which weigh lookups
+    // against inserts when adapting nodes. Lookups that do not count write
+    // nothing, so that several threads can run them at once.
+    bool count_lookups = true;
   };
   Params params_;
 
@@ -389,6 +395,13 @@ class Alex {
     params_.approximate_cost_computation = approximate_cost_computation;
   }
 
+  // Count lookups, or let const lookups run from several threads at once.
+  // Only turn counting off if no inserts follow, as nodes then adapt to them
+  // as if there had been no lookups.
+  void set_count_lookups(bool count_lookups) {
+    params_.count_lookups = count_lookups;
+  }
+
   /*** General helpers ***/
 
  public:
@@ -419,7 +432,7 @@ class Alex {
       }
       cur = node->children_[bucketID];
       if (cur->is_leaf_) {
-        stats_.num_node_lookups += cur->level_;
+        if (params_.count_lookups) stats_.num_node_lookups += cur->level_;
         auto leaf = static_cast<data_node_type*>(cur);
         // Doesn't really matter if rounding is incorrect, we just want it to be
         // fast.
@@ -472,7 +485,7 @@ class Alex {
       cur = node->children_[bucketID];
     }
 
-    stats_.num_node_lookups += cur->level_;
+    if (params_.count_lookups) stats_.num_node_lookups += cur->level_;
     return static_cast<data_node_type*>(cur);
   }
 #endif
@@ -641,10 +654,12 @@ class Alex {
   /*** Bulk loading ***/
 
  public:
-  // values should be the sorted array of key-payload pairs.
-  // The number of elements should be num_keys.
+  // values should be the sorted array of key-payload pairs, or a random access
+  // iterator yielding them. The number of elements should be num_keys.
   // The index must be empty when calling this method.
-  void bulk_load(const V values[], int num_keys) {
+  // With num_threads > 1, the subtrees below the root are loaded concurrently.
+  template <class ValueIt>
+  void bulk_load(ValueIt values, int num_keys, size_t num_threads = 1) {
     if (stats_.num_keys > 0 || num_keys <= 0) {
       return;
     }
@@ -671,8 +686,8 @@ class Alex {
         params_.approximate_cost_computation, &stats);
 
     // Recursively bulk load
-    bulk_load_node(values, num_keys, root_node_, num_keys,
-                   &root_data_node_model);
+    bulk_load_node(values, num_keys, root_node_, num_keys, stats_,
+                   &root_data_node_model, num_threads);
 
     if (root_node_->is_leaf_) {
       static_cast<data_node_type*>(root_node_)
@@ -727,15 +742,19 @@ class Alex {
   // node is trained as if it's a model node.
   // data_node_model is what the node's model would be if it were a data node of
   // dense keys.
-  void bulk_load_node(const V values[], int num_keys, AlexNode<T, P, SearchClass>*& node,
-                      int total_keys,
-                      const LinearModel<T>* data_node_model = nullptr) {
+  // Created nodes are counted in node_stats. The children of node are loaded
+  // by num_threads threads, each counting into its own stats.
+  template <class ValueIt>
+  void bulk_load_node(ValueIt values, int num_keys, AlexNode<T, P, SearchClass>*& node,
+                      int total_keys, Stats& node_stats,
+                      const LinearModel<T>* data_node_model = nullptr,
+                      size_t num_threads = 1) {
     // Automatically convert to data node when it is impossible to be better
     // than current cost
     if (num_keys <= derived_params_.max_data_node_slots *
                         data_node_type::kInitDensity_ &&
         (node->cost_ < kNodeLookupsWeight || node->model_.a_ == 0)) {
-      stats_.num_data_nodes++;
+      node_stats.num_data_nodes++;
       auto data_node = new (data_node_allocator().allocate(1))
           data_node_type(node->level_, derived_params_.max_data_node_slots,
                          key_less_, allocator_);
@@ -774,7 +793,7 @@ class Alex {
         num_keys > derived_params_.max_data_node_slots *
                        data_node_type::kInitDensity_) {
       // Convert to model node based on the output of the fanout tree
-      stats_.num_model_nodes++;
+      node_stats.num_model_nodes++;
       auto model_node = new (model_node_allocator().allocate(1))
           model_node_type(node->level_, allocator_);
       if (best_fanout_tree_depth == 0) {
@@ -803,7 +822,9 @@ class Alex {
       model_node->children_ =
           new (pointer_allocator().allocate(fanout)) AlexNode<T, P, SearchClass>*[fanout];
 
-      // Instantiate all the child nodes and recurse
+      // Instantiate all the child nodes
+      std::vector<int> child_positions;
+      child_positions.reserve(used_fanout_tree_nodes.size());
       int cur = 0;
       for (fanout_tree::FTNode& tree_node : used_fanout_tree_nodes) {
         auto child_node = new (model_node_allocator().allocate(1))
@@ -826,31 +847,64 @@ class Alex {
           child_node->model_.b_ = -child_node->model_.a_ * left_boundary;
         }
         model_node->children_[cur] = child_node;
+        child_positions.push_back(cur);
+        cur += repeats;
+      }
+
+      // Recurse into the children; each one only touches its own key range
+      // and its own slots of children_
+      auto load_child = [&](size_t i, Stats& child_stats) {
+        const fanout_tree::FTNode& tree_node = used_fanout_tree_nodes[i];
+        int pos = child_positions[i];
+        int repeats = 1 << (best_fanout_tree_depth - tree_node.level);
         LinearModel<T> child_data_node_model(tree_node.a, tree_node.b);
         bulk_load_node(values + tree_node.left_boundary,
                        tree_node.right_boundary - tree_node.left_boundary,
-                       model_node->children_[cur], total_keys,
+                       model_node->children_[pos], total_keys, child_stats,
                        &child_data_node_model);
-        model_node->children_[cur]->duplication_factor_ =
+        model_node->children_[pos]->duplication_factor_ =
             static_cast<uint8_t>(best_fanout_tree_depth - tree_node.level);
-        if (model_node->children_[cur]->is_leaf_) {
-          static_cast<data_node_type*>(model_node->children_[cur])
+        if (model_node->children_[pos]->is_leaf_) {
+          static_cast<data_node_type*>(model_node->children_[pos])
               ->expected_avg_exp_search_iterations_ =
               tree_node.expected_avg_search_iterations;
-          static_cast<data_node_type*>(model_node->children_[cur])
+          static_cast<data_node_type*>(model_node->children_[pos])
               ->expected_avg_shifts_ = tree_node.expected_avg_shifts;
         }
-        for (int i = cur + 1; i < cur + repeats; i++) {
-          model_node->children_[i] = model_node->children_[cur];
+        for (int j = pos + 1; j < pos + repeats; j++) {
+          model_node->children_[j] = model_node->children_[pos];
+        }
+      };
+      if (num_threads <= 1) {
+        for (size_t i = 0; i < used_fanout_tree_nodes.size(); i++) {
+          load_child(i, node_stats);
+        }
+      } else {
+        std::vector<Stats> thread_stats(num_threads);
+        std::atomic<size_t> next_child(0);
+        std::vector<std::thread> workers;
+        for (size_t t = 0; t < num_threads; t++) {
+          workers.emplace_back([&, t] {
+            for (size_t i = next_child++; i < used_fanout_tree_nodes.size();
+                 i = next_child++) {
+              load_child(i, thread_stats[t]);
+            }
+          });
+        }
+        for (auto& worker : workers) {
+          worker.join();
+        }
+        for (const Stats& child_stats : thread_stats) {
+          node_stats.num_model_nodes += child_stats.num_model_nodes;
+          node_stats.num_data_nodes += child_stats.num_data_nodes;
         }
-        cur += repeats;
       }
 
       delete_node(node);
       node = model_node;
     } else {
       // Convert to data node
-      stats_.num_data_nodes++;
+      node_stats.num_data_nodes++;
       auto data_node = new (data_node_allocator().allocate(1))
           data_node_type(node->level_, derived_params_.max_data_node_slots,
                          key_less_, allocator_);
@@ -922,9 +976,9 @@ class Alex {
   }
 
   typename self_type::ConstIterator find(const T& key) const {
-    stats_.num_lookups++;
+    if (params_.count_lookups) stats_.num_lookups++;
     data_node_type* leaf = get_leaf(key);
-    int idx = leaf->find_key(key);
+    int idx = leaf->find_key(key, params_.count_lookups);
     if (idx < 0) {
       return cend();
     } else {
@@ -952,9 +1006,9 @@ class Alex {
   }
 
   typename self_type::ConstIterator lower_bound(const T& key) const {
-    stats_.num_lookups++;
+    if (params_.count_lookups) stats_.num_lookups++;
     data_node_type* leaf = get_leaf(key);
-    int idx = leaf->find_lower(key);
+    int idx = leaf->find_lower(key, params_.count_lookups);
     return ConstIterator(leaf, idx);  // automatically handles the case where
                                       // idx == leaf->data_capacity
   }
@@ -969,9 +1023,9 @@ class Alex {
   }
 
   typename self_type::ConstIterator upper_bound(const T& key) const {
-    stats_.num_lookups++;
+    if (params_.count_lookups) stats_.num_lookups++;
     data_node_type* leaf = get_leaf(key);
-    int idx = leaf->find_upper(key);
+    int idx = leaf->find_upper(key, params_.count_lookups);
     return ConstIterator(leaf, idx);  // automatically handles the case where
                                       // idx == leaf->data_capacity
   }
@@ -989,9 +1043,9 @@ class Alex {
   // This avoids the overhead of creating an iterator
   // Returns null pointer if there is no exact match of the key
   P* get_payload(const T& key) const {
-    stats_.num_lookups++;
+    if (params_.count_lookups) stats_.num_lookups++;
     data_node_type* leaf = get_leaf(key);
-    int idx = leaf->find_key(key);
+    int idx = leaf->find_key(key, params_.count_lookups);
     if (idx < 0) {
       return nullptr;
     } else {
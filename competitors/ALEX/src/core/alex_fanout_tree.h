@@ -110,8 +110,9 @@ static double merge_nodes_upwards(
 // used_fanout_tree_nodes.
 // Assumes node has already been trained to produce a CDF value in the range [0,
 // 1).
-template <class T, class P, class SearchClass, class Compare = std::less<T>>
-double compute_level(const std::pair<T, P> values[], int num_keys,
+template <class T, class P, class SearchClass, class Compare = std::less<T>,
+          class ValueIt = const std::pair<T, P>*>
+double compute_level(ValueIt values, int num_keys,
                      const AlexNode<T, P, SearchClass>* node, int total_keys,
                      std::vector<FTNode>& used_fanout_tree_nodes, int level,
                      int max_data_node_keys, double expected_insert_frac = 0,
@@ -182,9 +183,10 @@ double compute_level(const std::pair<T, P> values[], int num_keys,
 // 1).
 // Returns the depth of the best fanout tree and the total cost of the fanout
 // tree.
-template <class T, class P, class SearchClass, class Compare = std::less<T>>
+template <class T, class P, class SearchClass, class Compare = std::less<T>,
+          class ValueIt = const std::pair<T, P>*>
 std::pair<int, double> find_best_fanout_bottom_up(
-    const std::pair<T, P> values[], int num_keys, const AlexNode<T, P, SearchClass>* node,
+    ValueIt values, int num_keys, const AlexNode<T, P, SearchClass>* node,
     int total_keys, std::vector<FTNode>& used_fanout_tree_nodes, int max_fanout,
     int max_data_node_keys, double expected_insert_frac = 0,
     bool approximate_model_computation = true,
@@ -201,7 +203,7 @@ std::pair<int, double> find_best_fanout_bottom_up(
   for (int fanout = 2, fanout_tree_level = 1; fanout <= max_fanout;
        fanout *= 2, fanout_tree_level++) {
     std::vector<FTNode> new_level;
-    double cost = compute_level<T, P, SearchClass, Compare>(
+    double cost = compute_level<T, P, SearchClass, Compare, ValueIt>(
         values, num_keys, node, total_keys, new_level, fanout_tree_level,
         max_data_node_keys, expected_insert_frac, approximate_model_computation,
         approximate_cost_computation, key_less);
@@ -237,9 +239,10 @@ std::pair<int, double> find_best_fanout_bottom_up(
 // 1).
 // Returns the depth of the best fanout tree and the total cost of the fanout
 // tree.
-template <class T, class P, class SearchClass, class Compare = std::less<T>>
+template <class T, class P, class SearchClass, class Compare = std::less<T>,
+          class ValueIt = const std::pair<T, P>*>
 std::pair<int, double> find_best_fanout_top_down(
-    const std::pair<T, P> values[], int num_keys, const AlexNode<T, P, SearchClass>* node,
+    ValueIt values, int num_keys, const AlexNode<T, P, SearchClass>* node,
     int total_keys, std::vector<FTNode>& used_fanout_tree_nodes, int max_fanout,
     double expected_insert_frac = 0, bool approximate_model_computation = true,
     bool approximate_cost_computation = false, Compare key_less = Compare()) {
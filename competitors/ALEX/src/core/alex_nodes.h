@@ -753,8 +753,9 @@ class AlexDataNode : public AlexNode<T, P, SearchClass> {
   // Computes the expected cost of a data node constructed using the input dense
   // array of keys
   // Assumes existing_model is trained on the dense array of keys
+  template <class ValueIt>
   static double compute_expected_cost(
-      const V* values, int num_keys, double density,
+      ValueIt values, int num_keys, double density,
       double expected_insert_frac,
       const LinearModel<T>* existing_model = nullptr, bool use_sampling = false,
       DataNodeStats* stats = nullptr) {
@@ -809,7 +810,8 @@ class AlexDataNode : public AlexNode<T, P, SearchClass> {
 
   // Helper function for compute_expected_cost
   // Implicitly build the data node in order to collect the stats
-  static void build_node_implicit(const V* values, int num_keys,
+  template <class ValueIt>
+  static void build_node_implicit(ValueIt values, int num_keys,
                                   int data_capacity, StatAccumulator* acc,
                                   const LinearModel<T>* model) {
     int last_position = -1;
@@ -841,8 +843,9 @@ class AlexDataNode : public AlexNode<T, P, SearchClass> {
   // Assumes existing_model is trained on the dense array of keys
   // Uses progressive sampling: keep increasing the sample size until the
   // computed stats stop changing drastically
+  template <class ValueIt>
   static double compute_expected_cost_sampling(
-      const V* values, int num_keys, double density,
+      ValueIt values, int num_keys, double density,
       double expected_insert_frac,
       const LinearModel<T>* existing_model = nullptr,
       DataNodeStats* stats = nullptr) {
@@ -1006,7 +1009,8 @@ class AlexDataNode : public AlexNode<T, P, SearchClass> {
   // sample_num_keys and sample_data_capacity refer to a data node that is
   // created only over the sample
   // sample_model is trained for the sampled data node
-  static void build_node_implicit_sampling(const V* values, int num_keys,
+  template <class ValueIt>
+  static void build_node_implicit_sampling(ValueIt values, int num_keys,
                                            int sample_num_keys,
                                            int sample_data_capacity,
                                            int step_size, StatAccumulator* ent,
@@ -1151,8 +1155,14 @@ class AlexDataNode : public AlexNode<T, P, SearchClass> {
 #endif
   }
 
+  // For empty nodes, which are loaded from nullptr.
+  void bulk_load(std::nullptr_t, int num_keys) {
+    bulk_load(static_cast<const V*>(nullptr), num_keys);
+  }
+
   // Assumes pretrained_model is trained on dense array of keys
-  void bulk_load(const V values[], int num_keys,
+  template <class ValueIt>
+  void bulk_load(ValueIt values, int num_keys,
                  const LinearModel<T>* pretrained_model = nullptr,
                  bool train_with_sample = false) {
     initialize(num_keys, kInitDensity_);
@@ -1339,7 +1349,8 @@ class AlexDataNode : public AlexNode<T, P, SearchClass> {
     contraction_threshold_ = data_capacity_ * kMinDensity_;
   }
 
-  static void build_model(const V* values, int num_keys, LinearModel<T>* model,
+  template <class ValueIt>
+  static void build_model(ValueIt values, int num_keys, LinearModel<T>* model,
                           bool use_sampling = false) {
     if (use_sampling) {
       build_model_sampling(values, num_keys, model);
@@ -1356,7 +1367,8 @@ class AlexDataNode : public AlexNode<T, P, SearchClass> {
   // Uses progressive non-random uniform sampling to build the model
   // Progressively increases sample size until model parameters are relatively
   // stable
-  static void build_model_sampling(const V* values, int num_keys,
+  template <class ValueIt>
+  static void build_model_sampling(ValueIt values, int num_keys,
                                    LinearModel<T>* model,
                                    bool verbose = false) {
     const static int sample_size_lower_bound = 10;
@@ -1433,7 +1445,8 @@ class AlexDataNode : public AlexNode<T, P, SearchClass> {
   // Unused function: builds a spline model by connecting the smallest and
   // largest points instead of using
   // a linear regression
-  static void build_spline(const V* values, int num_keys,
+  template <class ValueIt>
+  static void build_spline(ValueIt values, int num_keys,
                            const LinearModel<T>* model) {
     int y_max = num_keys - 1;
     int y_min = 0;
@@ -1453,8 +1466,8 @@ class AlexDataNode : public AlexNode<T, P, SearchClass> {
 
   // Searches for the last non-gap position equal to key
   // If no positions equal to key, returns -1
-  int find_key(const T& key) {
-    num_lookups_++;
+  int find_key(const T& key, bool count_lookup = true) {
+    if (count_lookup) num_lookups_++;
     int predicted_pos = predict_position(key);
 
     // The last key slot with a certain value is guaranteed to be a real key
@@ -1470,8 +1483,8 @@ class AlexDataNode : public AlexNode<T, P, SearchClass> {
   // Searches for the first non-gap position no less than key
   // Returns position in range [0, data_capacity]
   // Compare with lower_bound()
-  int find_lower(const T& key) {
-    num_lookups_++;
+  int find_lower(const T& key, bool count_lookup = true) {
+    if (count_lookup) num_lookups_++;
     int predicted_pos = predict_position(key);
 
     int pos = exponential_search_lower_bound(predicted_pos, key);
@@ -1481,8 +1494,8 @@ class AlexDataNode : public AlexNode<T, P, SearchClass> {
   // Searches for the first non-gap position greater than key
   // Returns position in range [0, data_capacity]
   // Compare with upper_bound()
-  int find_upper(const T& key) {
-    num_lookups_++;
+  int find_upper(const T& key, bool count_lookup = true) {
+    if (count_lookup) num_lookups_++;
     int predicted_pos = predict_position(key);
 
     int pos = exponential_search_upper_bound(predicted_pos, key);
@@ -43,6 +43,8 @@
 #include <ostream>
 #include <memory>
 #include <cstddef>
+#include <thread>
+#include <vector>
 #include <assert.h>
 
 // *** Debugging Macros
@@ -2455,8 +2457,10 @@ public:
 
     /// Bulk load a sorted range. Loads items into leaves and constructs a
     /// B-tree above them. The tree must be empty when calling this function.
+    /// The leaves are allocated and linked in order, then filled by
+    /// num_threads threads, each copying a contiguous run of leaves.
     template <typename Iterator>
-    void bulk_load(Iterator ibegin, Iterator iend)
+    void bulk_load(Iterator ibegin, Iterator iend, size_t num_threads = 1)
     {
         BTREE_ASSERT(empty());
 
@@ -2468,18 +2472,15 @@ public:
 
         BTREE_PRINT("mabtree::bulk_load, level 0: " << m_stats.itemcount << " items into " << num_leaves << " leaves with up to " << ((iend - ibegin + num_leaves-1) / num_leaves) << " items per leaf.");
 
-        Iterator it = ibegin;
+        std::vector<std::pair<leaf_node*, size_t> > leaves(num_leaves);
+        size_t offset = 0;
         for (size_t i = 0; i < num_leaves; ++i)
         {
             // allocate new leaf node
             leaf_node* leaf = allocate_leaf();
 
-            // copy keys or (key,value) pairs into leaf nodes, uses template
-            // switch leaf->set_slot().
             leaf->slotuse = static_cast<int>(num_items / (num_leaves-i));
-            for (size_t s = 0; s < leaf->slotuse; ++s, ++it)
-                leaf->set_slot(s, *it);
-            compute_midp_err(leaf);
+            leaves[i] = std::make_pair(leaf, offset);
 
             if (m_tailleaf != NULL) {
                 m_tailleaf->nextleaf = leaf;
@@ -2490,10 +2491,31 @@ public:
             }
             m_tailleaf = leaf;
 
+            offset += leaf->slotuse;
             num_items -= leaf->slotuse;
         }
 
-        BTREE_ASSERT( it == iend && num_items == 0 );
+        BTREE_ASSERT( ibegin + offset == iend && num_items == 0 );
+
+        // copy keys or (key,value) pairs into leaf nodes, uses template
+        // switch leaf->set_slot().
+        num_threads = std::max<size_t>(1, std::min(num_threads, num_leaves));
+        auto fill = [&](size_t t) {
+            for (size_t i = num_leaves * t / num_threads; i < num_leaves * (t+1) / num_threads; ++i)
+            {
+                leaf_node* leaf = leaves[i].first;
+                Iterator it = ibegin + leaves[i].second;
+                for (size_t s = 0; s < leaf->slotuse; ++s, ++it)
+                    leaf->set_slot(s, *it);
+                compute_midp_err(leaf);
+            }
+        };
+        std::vector<std::thread> workers;
+        for (size_t t = 1; t < num_threads; ++t)
+            workers.emplace_back(fill, t);
+        fill(0);
+        for (size_t t = 0; t < workers.size(); ++t)
+            workers[t].join();
 
         // if the btree is so small to fit into one leaf, then we're done.
         if (m_headleaf == m_tailleaf) {
@@ -92,8 +92,8 @@ class PGMIndex {
             // } else {
                 auto level_size = levels_sizes[l];
                 auto hi = level_begin + ADD_ERR(pos, RecursiveError + 2, level_size);
-                it = SearchClass::upper_bound(lo, hi, key, lo, std::function<K(Iterator)>([](Iterator it)->K{
-                                                                               return  it->key; }));
+                it = SearchClass::upper_bound(lo, hi, key, lo, [](Iterator it)->K{
+                                                                               return  it->key; });
                 it = it == level_begin ? it : std::prev(it);
             // }
         }
@@ -209,6 +209,36 @@ public:
     size_t size_in_bytes() const {
         return segments.size() * sizeof(Segment);
     }
+
+    /**
+     * Adds the index to a snapshot, one section per member.
+     * @param out a writer with Add(data, count) and AddValue(value)
+     */
+    template<typename Writer>
+    void save(Writer &out) const {
+        out.AddValue(n);
+        out.AddValue(first_key);
+        out.Add(segments.data(), segments.size());
+        out.Add(levels_sizes.data(), levels_sizes.size());
+        out.Add(levels_offsets.data(), levels_offsets.size());
+    }
+
+    /**
+     * Replaces the index by the one in the next sections of a snapshot. The segments are copied, as they are small
+     * next to the data.
+     * @param in a reader with Next<T>(), returning a span of the next section, and NextValue<T>()
+     */
+    template<typename Reader>
+    void load(Reader &in) {
+        n = in.template NextValue<size_t>();
+        first_key = in.template NextValue<K>();
+        auto s = in.template Next<Segment>();
+        segments.assign(s.begin(), s.end());
+        auto sizes = in.template Next<size_t>();
+        levels_sizes.assign(sizes.begin(), sizes.end());
+        auto offsets = in.template Next<size_t>();
+        levels_offsets.assign(offsets.begin(), offsets.end());
+    }
 };
 
 #pragma pack(push, 1)
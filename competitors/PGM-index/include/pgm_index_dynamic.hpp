@@ -328,6 +328,21 @@ public:
         insert(Item(key, value));
     }
 
+    /**
+     * Inserts an element into the container, replacing the value of the newest element with an equivalent key if
+     * that is in the sorted buffer for new items. Elements with an equivalent key in other levels are shadowed.
+     * @param key element key to insert or update
+     * @param value element value to insert
+     */
+    void insert_or_assign(const K &key, const V &value) {
+        auto insertion_point = std::lower_bound(data[0].begin(), data[0].end(), key);
+        if (insertion_point != data[0].end() && insertion_point->key() == key) {
+            *insertion_point = Item(key, value);
+            return;
+        }
+        insert(Item(key, value));
+    }
+
     /**
      * Removes the specified element from the container.
      * @param key key value of the element to remove
@@ -388,9 +403,6 @@ public:
                 continue;
 
             auto it = std::lower_bound(level.begin(), level.end(), key);
-            while (it != level.end() && it->deleted())
-                ++it;
-
             if (it != level.end()) {
                 initial_pairs.emplace_back(it, i);
                 if (!lo_is_set || it->key() < lo->key()){
@@ -421,7 +433,11 @@ public:
         }
 
         if (lo_is_set){
-            return iterator(this, lo, used_levels, initial_pairs);
+            // lo is the newest item of its key, which the iterator skips if it is a tombstone
+            iterator result(this, lo, used_levels, initial_pairs);
+            if (lo->deleted())
+                ++result;
+            return result;
         }
         return end();
     }
@@ -530,6 +546,7 @@ class DynamicPGMIndex<K, V, SearchClass, PGMType, MinIndexedLevel>::DynamicPGMIn
     const dynamic_pgm_type *super;
     internal_iterator it;
     uint8_t level{};
+    int16_t it_level{};  ///< Level of it, once the queue is initialized.
 
     std::vector<queue_pair> initial_pairs;
 
@@ -574,14 +591,16 @@ class DynamicPGMIndex<K, V, SearchClass, PGMType, MinIndexedLevel>::DynamicPGMIn
         }
 
         queue = decltype(queue)(&queue_cmp, initial_pairs);
-        advance_queue();
+        pop_queue();
         level = std::numeric_limits<decltype(level)>::max();
     }
 
-    void advance_queue() {
+    // Moves to the next item of all levels, in key order and newest level first
+    // among equal keys. Returns false at the end.
+    bool pop_queue() {
         if (queue.empty()) {
             *this = super->end();
-            return;
+            return false;
         }
 
         auto[tmp_it, from_level] = queue.top();
@@ -592,6 +611,28 @@ class DynamicPGMIndex<K, V, SearchClass, PGMType, MinIndexedLevel>::DynamicPGMIn
             queue.emplace(new_it, from_level);
 
         it = tmp_it;
+        it_level = from_level;
+        return true;
+    }
+
+    // Moves to the next item in the container, skipping tombstones, the items
+    // of their key after them, and the items of older levels that a newer item
+    // of the same key shadows.
+    void advance_queue() {
+        K shadow_key = it->key();
+        int16_t shadow_level = it_level;
+        bool shadow_deleted = it->deleted();
+        while (pop_queue()) {
+            if (it->key() == shadow_key && (shadow_deleted || it_level != shadow_level))
+                continue;
+            if (it->deleted()) {
+                shadow_key = it->key();
+                shadow_level = it_level;
+                shadow_deleted = true;
+                continue;
+            }
+            return;
+        }
     }
 
     DynamicPGMIndexIterator() = default;
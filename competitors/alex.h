@@ -2,6 +2,7 @@
 
 #include <utility>
 
+#include "../utils/projection.h"
 #include "./ALEX/src/core/alex.h"
 #include "./ALEX/src/core/alex_base.h"
 #include "base.h"
@@ -11,16 +12,11 @@ class Alex : public Competitor<KeyType, SearchClass> {
  public:
   Alex(const std::vector<int>& params): max_node_logsize(params[0]){}
   uint64_t Build(const std::vector<KeyValue<KeyType>>& data, const size_t num_threads) {
-    std::vector<std::pair<KeyType, uint64_t>> loading_data;
-    loading_data.reserve(data.size());
-    for (const auto& itm : data) {
-      loading_data.push_back(std::make_pair(itm.key, itm.value));
-    }
-    
+    const auto pairs = util::pairs_of(data);
     map_.set_max_node_size(1 << max_node_logsize);
 
     return util::timing(
-        [&] { map_.bulk_load(loading_data.data(), loading_data.size()); });
+        [&] { map_.bulk_load(pairs.begin(), data.size(), num_threads); });
   }
 
   size_t EqualityLookup(const KeyType lookup_key, uint32_t thread_id) const {
@@ -50,10 +46,30 @@ class Alex : public Competitor<KeyType, SearchClass> {
     map_.insert(std::make_pair(data.key, data.value));
   }
 
+  // Data nodes contract once sparse enough, and empty ones are merged away.
+  void Delete(const KeyType& key, uint32_t thread_id) {
+    map_.erase_one(key);
+  }
+
+  void Update(const KeyValue<KeyType>& data, uint32_t thread_id) {
+    uint64_t* payload = map_.get_payload(data.key);
+    if (payload) {
+      *payload = data.value;
+    }
+  }
+
+  bool deletable() const { return true; }
+
   std::string name() const { return "ALEX"; }
 
   std::size_t size() const { return map_.model_size() + map_.data_size(); }
 
+  // Lookups count themselves in the nodes only to adapt them to inserts.
+  bool concurrentReads() {
+    map_.set_count_lookups(false);
+    return true;
+  }
+
   bool applicable(bool unique, bool range_query, bool insert, bool multithread, const std::string& ops_filename) const {
     // The max_data_node_slots should > 21026, 
     // which is the maximum repeated num in dataset wiki_ts_200M_uint64
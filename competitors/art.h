@@ -16,6 +16,7 @@
 #include <stack>
 
 #include "../util.h"
+#include "../utils/projection.h"
 #include "base.h"
 
 // Uses ART as a non-clustered primary index that stores <key, offset> pairs.
@@ -34,15 +35,8 @@ class ART : public Base<KeyType> {
   }
 
   uint64_t Build(const std::vector<KeyValue<KeyType>>& data, size_t num_threads) {
-    std::vector<KeyValue<std::string>> transform_data(data.size());
-
     return util::timing([&] {
-      for (size_t i = 0; i < data.size(); ++i) {
-        util::convert2String(data[i].key, transform_data[i].key);
-        Element<std::string>* e = new Element<std::string>(transform_data[i].key, data[i].value);
-        transform_data[i].value = (uint64_t(e) >> 1);
-      }
-      bulk_insert(&tree_, transform_data, 0, data.size(), 0);
+      bulk_insert(&tree_, data, 0, data.size(), 0);
     });
   }
 
@@ -80,9 +74,35 @@ class ART : public Base<KeyType> {
     insert(tree_, &tree_, static_cast<const uint8_t*>(static_cast<const void*>(key.c_str())), key.length(), 0, uint64_t(e) >> 1);
   }
 
+  // Unlinks the leaf, shrinking its node if need be, then frees its element.
+  void Delete(const KeyType& key, uint32_t thread_id) {
+    std::string str;
+    util::convert2String(key, str);
+    const uint8_t* bytes = static_cast<const uint8_t*>(static_cast<const void*>(str.c_str()));
+
+    Node* node = lookup(tree_, bytes, str.length(), 0);
+    if (node){
+      Element<std::string>* e = reinterpret_cast<Element<std::string>*>(getLeafValue(node) << 1);
+      erase(tree_, &tree_, bytes, str.length(), 0);
+      delete e;
+    }
+  }
+
+  void Update(const KeyValue<KeyType>& data, uint32_t thread_id) {
+    std::string key;
+    util::convert2String(data.key, key);
+
+    Node* node = lookup(tree_, static_cast<const uint8_t*>(static_cast<const void*>(key.c_str())), key.length(), 0);
+    if (node){
+      reinterpret_cast<Element<std::string>*>(getLeafValue(node) << 1)->value = data.value;
+    }
+  }
+
+  bool deletable() const { return true; }
+
   std::string name() const { return "ART"; }
 
-  std::size_t size() const { return size_in_bytes(tree_); }
+  std::size_t size() const { return tree_ ? size_in_bytes(tree_) : 0; }
 
   bool applicable(bool unique, bool range_query, bool insert, bool multithread, const std::string& _ops_filename) const {
     return unique && !multithread;
@@ -850,8 +870,9 @@ class ART : public Base<KeyType> {
     node->child[keyByte] = child;
   }
 
-  void bulk_insert(Node** nodeRef, const std::vector<KeyValue<std::string>>& bulkVec, size_t first, size_t end, unsigned depth) {
-    // Bulk insert leaf values into the tree
+  void bulk_insert(Node** nodeRef, const std::vector<KeyValue<KeyType>>& bulkVec, size_t first, size_t end, unsigned depth) {
+    // Bulk insert leaf values into the tree, partitioning the dataset by the
+    // bytes of its binary-comparable keys, which are never materialized
 
     // Empty array
     if (first == end) {
@@ -860,7 +881,10 @@ class ART : public Base<KeyType> {
     }
     // Allocate new leaf
     if (end - first == 1){
-      *nodeRef = makeLeaf(bulkVec[first].value);
+      std::string key;
+      util::convert2String(bulkVec[first].key, key);
+      Element<std::string>* e = new Element<std::string>(key, bulkVec[first].value);
+      *nodeRef = makeLeaf(uint64_t(e) >> 1);
       return;
     }
 
@@ -870,8 +894,8 @@ class ART : public Base<KeyType> {
       std::vector<size_t> vec = {first};
       size_t cur = first;
       while(cur != end){
-        size_t found = std::upper_bound(bulkVec.begin() + cur + 1, bulkVec.begin() + end, (uint8_t)(bulkVec[cur].key[curDepth]), [&](uint8_t c, const KeyValue<std::string>& e) {
-                            return c < (uint8_t)(e.key[curDepth]);
+        size_t found = std::upper_bound(bulkVec.begin() + cur + 1, bulkVec.begin() + end, util::key_byte(bulkVec[cur].key, curDepth), [&](uint8_t c, const KeyValue<KeyType>& e) {
+                            return c < util::key_byte(e.key, curDepth);
                           }) - bulkVec.begin();
         vec.push_back(found);
         cur = found;
@@ -888,34 +912,36 @@ class ART : public Base<KeyType> {
       if (count <= 4){
         newNode = new Node4();
         for (size_t i = 0; i < count; i ++){
-          ((Node4*)newNode)->key[i] = bulkVec[vec[i]].key[curDepth];
+          ((Node4*)newNode)->key[i] = util::key_byte(bulkVec[vec[i]].key, curDepth);
           bulk_insert(&((Node4*)newNode)->child[i], bulkVec, vec[i], vec[i + 1], curDepth + 1);
         }
       }
       else if (count <= 16){
         newNode = new Node16();
         for (size_t i = 0; i < count; i ++){
-          ((Node16*)newNode)->key[i] = bulkVec[vec[i]].key[curDepth];
+          ((Node16*)newNode)->key[i] = util::key_byte(bulkVec[vec[i]].key, curDepth);
           bulk_insert(&((Node16*)newNode)->child[i], bulkVec, vec[i], vec[i + 1], curDepth + 1);
         }
       }
       else if (count <= 48){
         newNode = new Node48();
         for (size_t i = 0; i < count; i ++){
-          ((Node48*)newNode)->childIndex[(uint8_t)(bulkVec[vec[i]].key[curDepth])] = i;
+          ((Node48*)newNode)->childIndex[util::key_byte(bulkVec[vec[i]].key, curDepth)] = i;
           bulk_insert(&((Node48*)newNode)->child[i], bulkVec, vec[i], vec[i + 1], curDepth + 1);
         }
       }
       else {
         newNode = new Node256();
         for (unsigned i = 0; i < count; i++){
-          bulk_insert(&((Node256*)newNode)->child[(uint8_t)(bulkVec[vec[i]].key[curDepth])], bulkVec, vec[i], vec[i + 1], curDepth + 1);
+          bulk_insert(&((Node256*)newNode)->child[util::key_byte(bulkVec[vec[i]].key, curDepth)], bulkVec, vec[i], vec[i + 1], curDepth + 1);
         }
       }
       *nodeRef = newNode;
       newNode->count = count;
       newNode->prefixLength = curDepth - depth;
-      memcpy(newNode->prefix, bulkVec[first].key.c_str() + depth, min(curDepth - depth, maxPrefixLength));
+      for (unsigned i = 0; i < min(curDepth - depth, maxPrefixLength); i ++){
+        newNode->prefix[i] = util::key_byte(bulkVec[first].key, depth + i);
+      }
       break;
     }
   }
@@ -1013,10 +1039,10 @@ class ART : public Base<KeyType> {
     if (node->count == 3) {
       // Shrink to Node4
       Node4* newNode = new Node4();
-      newNode->count = 4;
+      newNode->count = 3;
       copyPrefix(node, newNode);
-      for (unsigned i = 0; i < 4; i++) newNode->key[i] = node->key[i];
-      memcpy(newNode->child, node->child, sizeof(uintptr_t) * 4);
+      for (unsigned i = 0; i < 3; i++) newNode->key[i] = node->key[i];
+      memcpy(newNode->child, node->child, sizeof(uintptr_t) * 3);
       *nodeRef = newNode;
       delete node;
     }
@@ -40,13 +40,17 @@ class ARTOLC : public Base<KeyType> {
   uint64_t Build(const std::vector<KeyValue<KeyType>>& data, const size_t num_threads) {
     num_workers_ = num_threads;
     return util::timing( [&] { 
-        auto t = tree_->getThreadInfo();
-        for (uint64_t i = 0; i < data.size(); i ++) {
-            Element<KeyType>* e = new Element<KeyType>(data[i].key, data[i].value);
-            Key key;
-            convert2Key(data[i].key, key);
-            tree_->insert(key, uint64_t(e) >> 1, t);
-        } 
+        // Each thread inserts a contiguous range, so that the threads
+        // only meet in the upper levels of the trie.
+        util::parallel_for(data.size(), num_threads, [&](size_t begin, size_t end) {
+            auto t = tree_->getThreadInfo();
+            for (uint64_t i = begin; i < end; i ++) {
+                Element<KeyType>* e = new Element<KeyType>(data[i].key, data[i].value);
+                Key key;
+                convert2Key(data[i].key, key);
+                tree_->insert(key, uint64_t(e) >> 1, t);
+            }
+        });
     });
   }
 
@@ -94,37 +98,6 @@ class ARTOLC : public Base<KeyType> {
     return unique;
   }
 
-  uint64_t runMultithread(void *(* func)(void *), FGParam *params) {
-    pthread_t threads[num_workers_];
-
-    for (size_t worker_i = 0; worker_i < num_workers_; worker_i++) {
-      int ret = pthread_create(&threads[worker_i], nullptr, func,
-                              (void *)&params[worker_i]);
-      if (ret) {
-        std::cout << "Error: " << ret << std::endl;
-      }
-    }
-
-    std::cout << "[micro] prepare data ...\n";
-    while (util::ready_threads < num_workers_) sleep(1);
-    util::running = true;
-
-    uint64_t timing = util::timing([&] {
-      while (util::running)
-        ;
-    });
-
-    void *status;
-    for (size_t i = 0; i < num_workers_; i++) {
-      int rc = pthread_join(threads[i], &status);
-      if (rc) {
-        std::cout << "Error:unable to join, " << rc << std::endl;
-      }
-    }
-    
-    return timing;
-  }
-
   static void loadKey(uint64_t tid, Key &key) {
     convert2Key(reinterpret_cast<Element<KeyType>*>(tid << 1)->key, key);
   }
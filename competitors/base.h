@@ -14,12 +14,31 @@ class Base {
     return util::NOT_FOUND;
   }
 
+  // Looks up n keys at once and stores the result of each in out.
+  // Returns false if the index has no native batched lookup,
+  // in which case the harness issues the lookups one by one.
+  bool EqualityLookupBatch(const KeyType*, size_t, size_t*, uint32_t) const {
+    return false;
+  }
+
   uint64_t RangeQuery(const KeyType&, const KeyType&, uint32_t) const {
     return 0;
   }
   
   void Insert(const KeyValue<KeyType>&, uint32_t) {}
 
+  // Removes the pair of a key, and replaces the value of a key.
+  // Workloads with deletes or updates only run on indexes whose
+  // deletable() says they implement both.
+  void Delete(const KeyType&, uint32_t) {}
+  void Update(const KeyValue<KeyType>&, uint32_t) {}
+  bool deletable() const { return false; }
+
+  // Writes the built index to a snapshot file, or replaces the index by the
+  // one of a snapshot file. Both return false if the index has no snapshots.
+  bool Save(const std::string&) const { return false; }
+  bool Load(const std::string&) { return false; }
+
   std::string name() const { return "Unknown"; }
 
   std::size_t size() const { return 0; }
@@ -28,6 +47,16 @@ class Base {
     return true;
   }
 
+  // Prepares the index for lookups and range queries from several threads
+  // at once, with no updates running. Returns false if it can not serve them,
+  // in which case such workloads only run if applicable() accepts them as
+  // multithreaded.
+  bool concurrentReads() { return false; }
+
+  // Whether a child process forked from the built index can run operations
+  // on it. Threads are not forked, so indexes owning threads must say no.
+  bool forkable() const { return true; }
+
   std::vector<std::string> variants() const { 
     return std::vector<std::string>();
   }
@@ -35,15 +64,44 @@ class Base {
   double searchAverageTime() const { return 0; }
   double searchLatency(uint64_t op_cnt) const { return 0; }
   double searchBound() const { return 0; }
-  void initSearch() {}
-  uint64_t runMultithread(void *(* func)(void *), FGParam *params) { return 0; }
+  // Resets the search stats of num_threads threads.
+  void initSearch(size_t) {}
+  // Stats the searches of thread_id record to, or null to record nothing.
+  SearchStats* searchStats(uint32_t) { return nullptr; }
+  // Called on each worker thread before and after it executes operations.
+  void initThread(uint32_t) {}
+  void exitThread(uint32_t) {}
 };
 
 template<class KeyType, class SearchClass>
 class Competitor: public Base<KeyType> {
  public:
-  double searchAverageTime() const { return SearchClass::searchAverageTime(); }
-  double searchLatency(uint64_t op_cnt) const { return (double)SearchClass::searchTotalTime() / op_cnt; }
-  double searchBound() const { return SearchClass::searchBound(); }
-  void initSearch() { SearchClass::initSearch(); }
+  double searchAverageTime() const {
+    const SearchStats total = totalSearchStats();
+    return (double)total.timing / total.search_num;
+  }
+  double searchLatency(uint64_t op_cnt) const { return (double)totalSearchStats().timing / op_cnt; }
+  double searchBound() const {
+    const SearchStats total = totalSearchStats();
+    return double(total.sum_search_bound) / total.research_num;
+  }
+  void initSearch(size_t num_threads) { search_stats_.assign(num_threads, SearchStats()); }
+  SearchStats* searchStats(uint32_t thread_id) {
+    return thread_id < search_stats_.size() ? &search_stats_[thread_id] : nullptr;
+  }
+
+ private:
+  SearchStats totalSearchStats() const {
+    SearchStats total;
+    for (const auto& stats: search_stats_){
+      total.timing += stats.timing;
+      total.search_num += stats.search_num;
+      total.sum_search_bound += stats.sum_search_bound;
+      total.research_num += stats.research_num;
+    }
+    return total;
+  }
+
+  // One per thread, so that threads never write the same cache line.
+  std::vector<SearchStats> search_stats_;
 };
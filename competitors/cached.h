@@ -0,0 +1,249 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "../util.h"
+#include "base.h"
+
+// Set-associative cache of lookup results, each set filling one cache line.
+// Misses replace the slot under the set's CLOCK hand, which skips and clears
+// the slots hit since it last passed them. With a doorkeeper, a key is only
+// admitted on its second miss since the doorkeeper was last cleared, keeping
+// keys looked up once from evicting hot ones.
+template <class KeyType>
+class alignas(CACHELINE_SIZE) LookupCache {
+ public:
+  void Init(size_t bytes, bool doorkeeper) {
+    sets_.assign(std::max<size_t>(1, bytes / sizeof(Set)), Set());
+    if (doorkeeper){
+      const size_t bits = std::max<size_t>(64, sets_.size() * kWays * 8);
+      doorkeeper_.assign(size_t(1) << (64 - __builtin_clzll(bits - 1)) >> 6, 0);
+    }
+  }
+
+  bool initialized() const { return !sets_.empty(); }
+
+  bool Find(const KeyType& key, size_t* result) {
+    ++lookups_;
+    Set& set = sets_[SetOf(Hash(key))];
+    for (uint8_t way = 0; way < kWays; ++way){
+      if ((set.valid >> way & 1) && set.keys[way] == key){
+        set.referenced |= 1 << way;
+        *result = set.results[way];
+        ++hits_;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void Admit(const KeyType& key, size_t result) {
+    const uint64_t h = Hash(key);
+    if (!doorkeeper_.empty()){
+      const size_t bit = h & (doorkeeper_.size() * 64 - 1);
+      if (!(doorkeeper_[bit >> 6] >> (bit & 63) & 1)){
+        doorkeeper_[bit >> 6] |= uint64_t(1) << (bit & 63);
+        if (++doorkeeper_keys_ == doorkeeper_.size() * 8){
+          std::fill(doorkeeper_.begin(), doorkeeper_.end(), 0);
+          doorkeeper_keys_ = 0;
+        }
+        return;
+      }
+    }
+    Set& set = sets_[SetOf(h)];
+    while (set.referenced >> set.hand & 1){
+      set.referenced &= ~(1 << set.hand);
+      set.hand = (set.hand + 1) % kWays;
+    }
+    set.keys[set.hand] = key;
+    set.results[set.hand] = result;
+    set.valid |= 1 << set.hand;
+    set.hand = (set.hand + 1) % kWays;
+  }
+
+  void Erase(const KeyType& key) {
+    if (!initialized()){
+      return;
+    }
+    Set& set = sets_[SetOf(Hash(key))];
+    for (uint8_t way = 0; way < kWays; ++way){
+      if ((set.valid >> way & 1) && set.keys[way] == key){
+        set.valid &= ~(1 << way);
+        set.referenced &= ~(1 << way);
+      }
+    }
+  }
+
+  size_t size() const { return sets_.size() * sizeof(Set) + doorkeeper_.size() * sizeof(uint64_t); }
+
+  uint64_t hits() const { return hits_; }
+  uint64_t lookups() const { return lookups_; }
+
+ private:
+  // Leaves a word of the line for the valid and referenced bits and the hand.
+  static constexpr uint8_t kWays = (CACHELINE_SIZE - sizeof(uint64_t)) / (sizeof(KeyType) + sizeof(uint64_t));
+
+  struct alignas(CACHELINE_SIZE) Set {
+    KeyType keys[kWays];
+    uint64_t results[kWays];
+    uint8_t valid = 0, referenced = 0, hand = 0;
+  };
+
+  static uint64_t Hash(const KeyType& key) {
+    if constexpr (std::is_integral<KeyType>::value){
+      return util::mix64(key);
+    }
+    else{
+      return util::mix64(std::hash<KeyType>()(key));
+    }
+  }
+
+  // The doorkeeper takes the low bits of the hash, the set the high ones.
+  size_t SetOf(uint64_t h) const { return (h >> 32) * sets_.size() >> 32; }
+
+  std::vector<Set> sets_;
+  std::vector<uint64_t> doorkeeper_;
+  size_t doorkeeper_keys_ = 0;
+  uint64_t hits_ = 0, lookups_ = 0;
+};
+
+// Index behind a cache of the results of its lookups, one per worker thread
+// so that threads neither share nor synchronize their caches. params are
+// those of Index followed by the KiB of cache per thread and the admission
+// (0: every miss, 1: doorkeeper). Writes erase their key from all caches,
+// so workloads with writes run on a single thread.
+template <class KeyType, class Index>
+class Cached : public Base<KeyType> {
+ public:
+  Cached(const std::vector<int>& params)
+      : index_(std::vector<int>(params.begin(), params.end() - 2)),
+        cache_bytes_(size_t(params[params.size() - 2]) << 10),
+        doorkeeper_(params.back() != 0) {}
+
+  uint64_t Build(const std::vector<KeyValue<KeyType>>& data, const size_t num_threads) {
+    // Caches are allocated by the threads using them, see initThread().
+    caches_ = std::vector<LookupCache<KeyType>>(num_threads);
+    return index_.Build(data, num_threads);
+  }
+
+  size_t EqualityLookup(const KeyType lookup_key, uint32_t thread_id) const {
+    LookupCache<KeyType>& cache = caches_[thread_id];
+    size_t result;
+    if (!cache.Find(lookup_key, &result)){
+      result = index_.EqualityLookup(lookup_key, thread_id);
+      cache.Admit(lookup_key, result);
+    }
+    return result;
+  }
+
+  bool EqualityLookupBatch(const KeyType* lookup_keys, size_t n, size_t* out, uint32_t thread_id) const {
+    // Answer the hits from the cache, then pass the misses on to the index
+    // as a smaller batch.
+    LookupCache<KeyType>& cache = caches_[thread_id];
+    KeyType missed_keys[n];
+    size_t missed_pos[n], missed_out[n], m = 0;
+    for (size_t i = 0; i < n; ++i){
+      if (!cache.Find(lookup_keys[i], &out[i])){
+        missed_keys[m] = lookup_keys[i];
+        missed_pos[m++] = i;
+      }
+    }
+    if (!index_.EqualityLookupBatch(missed_keys, m, missed_out, thread_id)){
+      for (size_t j = 0; j < m; ++j){
+        missed_out[j] = index_.EqualityLookup(missed_keys[j], thread_id);
+      }
+    }
+    for (size_t j = 0; j < m; ++j){
+      out[missed_pos[j]] = missed_out[j];
+      cache.Admit(missed_keys[j], missed_out[j]);
+    }
+    return true;
+  }
+
+  uint64_t RangeQuery(const KeyType lower_key, const KeyType upper_key, uint32_t thread_id) const {
+    return index_.RangeQuery(lower_key, upper_key, thread_id);
+  }
+
+  void Insert(const KeyValue<KeyType>& data, uint32_t thread_id) {
+    index_.Insert(data, thread_id);
+    Invalidate(data.key);
+  }
+
+  void Delete(const KeyType& key, uint32_t thread_id) {
+    index_.Delete(key, thread_id);
+    Invalidate(key);
+  }
+
+  void Update(const KeyValue<KeyType>& data, uint32_t thread_id) {
+    index_.Update(data, thread_id);
+    Invalidate(data.key);
+  }
+
+  bool deletable() const { return index_.deletable(); }
+
+  std::string name() const { return "Cached" + index_.name(); }
+
+  std::size_t size() const {
+    size_t cache_size = 0;
+    for (const auto& cache: caches_){
+      cache_size += cache.size();
+    }
+    return index_.size() + cache_size;
+  }
+
+  bool applicable(bool unique, bool range_query, bool insert, bool multithread, const std::string& ops_filename) {
+    return !(insert && multithread) && index_.applicable(unique, range_query, insert, multithread, ops_filename);
+  }
+
+  bool concurrentReads() { return index_.concurrentReads(); }
+
+  bool forkable() const { return index_.forkable(); }
+
+  std::vector<std::string> variants() const {
+    std::vector<std::string> vec = index_.variants();
+    vec.push_back(doorkeeper_ ? "Doorkeeper" : "CLOCK");
+    vec.push_back(std::to_string(cache_bytes_ >> 10));
+    uint64_t hits = 0, lookups = 0;
+    for (const auto& cache: caches_){
+      hits += cache.hits();
+      lookups += cache.lookups();
+    }
+    char hit_ratio[32];
+    snprintf(hit_ratio, sizeof(hit_ratio), "%.4f", lookups ? double(hits) / lookups : 0);
+    vec.push_back(hit_ratio);
+    return vec;
+  }
+
+  double searchAverageTime() const { return index_.searchAverageTime(); }
+  double searchLatency(uint64_t op_cnt) const { return index_.searchLatency(op_cnt); }
+  double searchBound() const { return index_.searchBound(); }
+  void initSearch(size_t num_threads) { index_.initSearch(num_threads); }
+  SearchStats* searchStats(uint32_t thread_id) { return index_.searchStats(thread_id); }
+
+  // Allocating the cache on its thread places it near that thread.
+  void initThread(uint32_t thread_id) {
+    if (!caches_[thread_id].initialized()){
+      caches_[thread_id].Init(cache_bytes_, doorkeeper_);
+    }
+    index_.initThread(thread_id);
+  }
+
+  void exitThread(uint32_t thread_id) { index_.exitThread(thread_id); }
+
+ private:
+  void Invalidate(const KeyType& key) {
+    for (auto& cache: caches_){
+      cache.Erase(key);
+    }
+  }
+
+  Index index_;
+  const size_t cache_bytes_;
+  const bool doorkeeper_;
+  mutable std::vector<LookupCache<KeyType>> caches_;
+};
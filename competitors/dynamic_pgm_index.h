@@ -7,6 +7,7 @@
 #include <vector>
 
 #include "../util.h"
+#include "../utils/projection.h"
 #include "base.h"
 #include "pgm_index_dynamic.hpp"
 
@@ -15,14 +16,9 @@ class DynamicPGM : public Competitor<KeyType, SearchClass> {
  public:
   DynamicPGM(const std::vector<int>& params){}
   uint64_t Build(const std::vector<KeyValue<KeyType>>& data, size_t num_threads) {
-    std::vector<std::pair<KeyType, uint64_t>> loading_data;
-    loading_data.reserve(data.size());
-    for (const auto& itm : data) {
-      loading_data.emplace_back(itm.key, itm.value);
-    }
-
+    const auto pairs = util::pairs_of(data);
     uint64_t build_time =
-        util::timing([&] { pgm_ = decltype(pgm_)(loading_data.begin(), loading_data.end()); });
+        util::timing([&] { pgm_ = decltype(pgm_)(pairs.begin(), pairs.end()); });
 
     return build_time;
   }
@@ -54,6 +50,18 @@ class DynamicPGM : public Competitor<KeyType, SearchClass> {
     pgm_.insert(data.key, data.value);
   }
 
+  // Inserts a tombstone, which takes space until merged into the last level.
+  void Delete(const KeyType& key, uint32_t thread_id) {
+    pgm_.erase(key);
+  }
+
+  // Unless in the insert buffer, the old pair stays shadowed until a merge drops it.
+  void Update(const KeyValue<KeyType>& data, uint32_t thread_id) {
+    pgm_.insert_or_assign(data.key, data.value);
+  }
+
+  bool deletable() const { return true; }
+
   std::string name() const { return "DynamicPGM"; }
 
   std::size_t size() const { return pgm_.size_in_bytes(); }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "base.h"
+#include "soa_data.h"
 #include "./fast/src/fast.h"
 
 template<class KeyType>
@@ -8,45 +9,65 @@ class Fast : public Base<KeyType> {
  public:
   Fast(const std::vector<int>& params){}
   uint64_t Build(const std::vector<KeyValue<KeyType>>& data, size_t num_threads) {
-    const auto extract_key = [](KeyValue<KeyType> kv) { return kv.key; };
-    std::vector<KeyType> keys;
-    keys.reserve(data.size());
-    std::transform(data.begin(), data.end(), std::back_inserter(keys),
-                   extract_key);
-
     return util::timing([&] {
-      data_ = data;
-      fast_.buildFAST(keys.data(), data.size());
+      data_.Assign(data);
+      fast_.buildFAST(data_.keys(), data_.size());
     });
   }
 
   size_t EqualityLookup(const KeyType& lookup_key, uint32_t thread_id) const {
     size_t it = fast_.lower_bound(lookup_key);
-    if (it == data_.size() || data_[it].key != lookup_key){
+    if (it == data_.size() || data_.key(it) != lookup_key){
       return util::OVERFLOW;
     }
     return it;
   }
 
+  bool EqualityLookupBatch(const KeyType* lookup_keys, size_t n, size_t* out, uint32_t thread_id) const {
+    fast_.lower_bound_batch(lookup_keys, n, out);
+    for (size_t i = 0; i < n; ++i){
+      data_.Prefetch(out[i]);
+    }
+    for (size_t i = 0; i < n; ++i){
+      if (out[i] == data_.size() || data_.key(out[i]) != lookup_keys[i]){
+        out[i] = util::OVERFLOW;
+      }
+    }
+    return true;
+  }
+
   uint64_t RangeQuery(const KeyType& lower_key, const KeyType& upper_key, uint32_t thread_id) const {
-    size_t it = fast_.lower_bound(lower_key);
-    uint64_t result = 0;
-    while(it != data_.size() && data_[it].key <= upper_key){
-      result += data_[it].value;
-      ++it;
+    return data_.SumUpTo(fast_.lower_bound(lower_key), upper_key);
+  }
+
+  bool Save(const std::string& filename) const {
+    util::SnapshotWriter snapshot(sizeof(KeyType));
+    data_.Save(snapshot);
+    fast_.save(snapshot);
+    return snapshot.Write(filename);
+  }
+
+  bool Load(const std::string& filename) {
+    util::SnapshotReader snapshot;
+    if (!snapshot.Open(filename, sizeof(KeyType))){
+      return false;
     }
-    return result;
+    data_.Load(snapshot);
+    fast_.load(snapshot);
+    return true;
   }
 
   std::string name() const { return "FAST"; }
 
   std::size_t size() const { return fast_.size_in_byte() + (sizeof(KeyType) + sizeof(uint64_t)) * data_.size(); }
 
+  bool concurrentReads() { return true; }
+
   bool applicable(bool unique, bool range_query, bool insert, bool multithread, const std::string& _ops_filename) const {
     return unique && !insert && !multithread;
   }
 
  private:
-  std::vector<KeyValue<KeyType>> data_;
+  SoAData<KeyType> data_;
   FAST<KeyType> fast_;
 };
\ No newline at end of file
@@ -22,6 +22,7 @@
 #include <string.h>
 #include <algorithm>
 #include <vector>
+#include <memory>
 #include <random>
 #include <utility>
 #include <cmath>
@@ -36,11 +37,12 @@ public:
     FAST(): depth(0), len(0), v(nullptr), size_in_byte_(0){}
 
     ~FAST() {
-        munmap(v, size_in_byte_);
+        if (!owner) munmap(v, size_in_byte_);
     }
 
-    void buildFAST(KeyType l[], size_t _len) {
+    void buildFAST(const KeyType l[], size_t _len) {
         // create array of appropriate size
+        owner.reset();
         len = _len;
         depth = std::floor(std::log2(len)) + 1;
         unsigned depth_div_page = (depth - 1) / PAGE_CACHE_DEPTH;
@@ -112,9 +114,92 @@ public:
         return std::min(page_address, len);
     }
 
+    // Same as lower_bound for n keys, but walks the tree for all keys in lock step:
+    // the cacheline block of every key is prefetched before any of them is searched,
+    // so that the cache misses of different keys overlap.
+    void lower_bound_batch(const KeyType* keys_q, size_t n, size_t* out) const {
+        __m256i xmm_keys_q[n];
+        KeyType* cache_v[n];
+        KeyType* simd_v[n];
+        size_t page_address[n], page_offset[n], cache_offset[n];
+        for (size_t i = 0; i < n; ++i) {
+            init_simd(keys_q[i], xmm_keys_q[i]);
+            page_address[i] = 0;
+        }
+
+        KeyType* page_v = v;
+        for (unsigned page_level = 0; page_level < depth; page_level += PAGE_CACHE_DEPTH) {
+            unsigned page_depth = std::min(depth - page_level, PAGE_CACHE_DEPTH);
+            unsigned page_actual_depth = (page_level + PAGE_CACHE_DEPTH < depth) ? PAGE_DEPTH : page_depth + 1;
+            for (size_t i = 0; i < n; ++i) {
+                page_offset[i] = 0;
+                cache_v[i] = page_v + (page_address[i] << page_actual_depth);
+            }
+
+            for (unsigned cache_level = 0; cache_level < page_depth; cache_level += CACHE_LINE_DEPTH) {
+                unsigned cache_depth = std::min(CACHE_LINE_DEPTH, page_depth - cache_level);
+                for (size_t i = 0; i < n; ++i) {
+                    cache_offset[i] = 0;
+                    simd_v[i] = cache_v[i] + (page_offset[i] << cache_depth);
+                    _mm_prefetch((const char*)simd_v[i], _MM_HINT_T0);
+                }
+
+                for (size_t i = 0; i < n; ++i) {
+                    for (unsigned simd_level = 0; simd_level < cache_depth; simd_level += SIMD_DEPTH) {
+                        unsigned simd_depth = std::min(SIMD_DEPTH, cache_depth - simd_level);
+                        KeyType* child_v = simd_v[i] + (cache_offset[i] << simd_depth) - cache_offset[i];
+                        size_t child_index;
+
+                        if (simd_depth == SIMD_DEPTH){
+                            child_index = search_simd(child_v, xmm_keys_q[i]);
+                        }
+                        else{
+                            child_index = search_scalar(child_v, keys_q[i], simd_depth);
+                        }
+
+                        cache_offset[i] = (cache_offset[i] << simd_depth) + child_index;
+                        simd_v[i] += ((pow(simd_depth) - 1) << simd_level);
+                    }
+
+                    page_offset[i] = (page_offset[i] << cache_depth) + cache_offset[i];
+                    cache_v[i] += pow(cache_level + cache_depth);
+                }
+            }
+
+            for (size_t i = 0; i < n; ++i) {
+                page_address[i] = (page_address[i] << page_depth) + page_offset[i];
+            }
+            page_v += pow(page_level + page_actual_depth);
+        }
+
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = std::min(page_address[i], len);
+        }
+    }
+
     unsigned long long size_in_byte() const {
         return size_in_byte_;
     }
+
+    // add the tree to a snapshot
+    template<class Writer>
+    void save(Writer& out) const {
+        out.AddValue(len);
+        out.Add(v, size_in_byte_ / sizeof(KeyType));
+    }
+
+    // use the tree in the next sections of a snapshot in place,
+    // keeping the snapshot mapped as long as the tree
+    template<class Reader>
+    void load(Reader& in) {
+        if (!owner) munmap(v, size_in_byte_);
+        len = in.template NextValue<size_t>();
+        depth = std::floor(std::log2(len)) + 1;
+        const auto tree = in.template Next<KeyType>();
+        v = const_cast<KeyType*>(tree.data());
+        size_in_byte_ = sizeof(KeyType) * tree.size();
+        owner = in.file();
+    }
 private:
     const unsigned SIMD_SIZE = SIMD_BYTE / sizeof(KeyType);
     const unsigned CACHE_LINE_SIZE = CACHE_LINE_BYTE / sizeof(KeyType);
@@ -129,6 +214,8 @@ private:
     size_t len;
     KeyType* v;
     unsigned long long size_in_byte_;
+    // mapping of the snapshot `v` points into, if loaded
+    std::shared_ptr<const void> owner;
 
     void* malloc_huge(size_t size) {
         void* p=mmap(NULL,size,PROT_READ|PROT_WRITE,MAP_PRIVATE|MAP_ANONYMOUS,-1,0);
@@ -146,7 +233,7 @@ private:
         return i + (j - 1 - i) / 2;
     }
 
-    size_t storeSIMDblock(KeyType v[], size_t offset, KeyType l[], size_t i, size_t j, unsigned levels) {
+    size_t storeSIMDblock(KeyType v[], size_t offset, const KeyType l[], size_t i, size_t j, unsigned levels) {
         for (unsigned level = 0; level < levels; ++level) {
             const size_t level_num = pow(level);
             const size_t chunk = (j - i) / level_num;
@@ -158,7 +245,7 @@ private:
         return offset;
     }
 
-    size_t storeCachelineBlock(KeyType v[], size_t offset, KeyType l[], size_t i, size_t j, unsigned levels) {
+    size_t storeCachelineBlock(KeyType v[], size_t offset, const KeyType l[], size_t i, size_t j, unsigned levels) {
         size_t org_offset = offset;
         for (unsigned level = 0; level < levels; level += SIMD_DEPTH) {
             const size_t level_num = pow(level);
@@ -170,7 +257,7 @@ private:
         return org_offset + pow(levels);
     }
 
-    size_t storeFASTpage(KeyType v[], size_t offset, KeyType l[], size_t i, size_t j, unsigned levels) {
+    size_t storeFASTpage(KeyType v[], size_t offset, const KeyType l[], size_t i, size_t j, unsigned levels) {
         size_t org_offset = offset;
         for (unsigned level = 0; level < levels; level += CACHE_LINE_DEPTH) {
             const size_t level_num = pow(level);
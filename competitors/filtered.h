@@ -0,0 +1,224 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <dtl/bloomfilter/blocked_bloomfilter_logic.hpp>
+#include <dtl/bloomfilter/blocked_cuckoofilter_logic.hpp>
+#include <dtl/bloomfilter/hash_family.hpp>
+
+#include "../util.h"
+#include "base.h"
+
+// Blocked filter of dtl, split into partitions of at most 2^20 keys. dtl
+// filters take 32-bit keys: keys are hashed to 64 bits, the high half picks
+// the partition and the low half is the key within it, so that keys only
+// collide if they agree on both halves.
+template <class Logic>
+class PartitionedFilter {
+ public:
+  using word_t = typename std::remove_cv<typename Logic::word_t>::type;
+
+  void Init(size_t num_keys, size_t bits_per_key) {
+    num_partitions_ = std::max<size_t>(1, (num_keys + kPartitionKeys - 1) / kPartitionKeys);
+    logic_.reset(new Logic(std::max<size_t>(1, num_keys * bits_per_key / num_partitions_)));
+    words_per_partition_ = WordCount(*logic_);
+    words_.assign(num_partitions_ * words_per_partition_, 0);
+  }
+
+  template <class KeyType>
+  void insert(const KeyType& key) {
+    const uint64_t h = Hash(key);
+    logic_->insert(words_.data() + Partition(h), uint32_t(h));
+  }
+
+  template <class KeyType>
+  bool contains(const KeyType& key) const {
+    const uint64_t h = Hash(key);
+    return logic_->contains(words_.data() + Partition(h), uint32_t(h));
+  }
+
+  size_t size() const { return sizeof(*this) + sizeof(Logic) + words_.size() * sizeof(word_t); }
+
+ private:
+  static constexpr size_t kPartitionKeys = size_t(1) << 20;
+
+  // Mixed, for both halves to depend on all bits of the key.
+  template <class KeyType>
+  static uint64_t Hash(const KeyType& key) {
+    if constexpr (std::is_integral<KeyType>::value){
+      return util::mix64(key);
+    }
+    else{
+      return util::mix64(std::hash<KeyType>()(key));
+    }
+  }
+
+  size_t Partition(uint64_t h) const { return ((h >> 32) * num_partitions_ >> 32) * words_per_partition_; }
+
+  template <class L>
+  static auto WordCount(const L& logic) -> decltype(logic.word_cnt()) { return logic.word_cnt(); }
+  template <class L, class... Unused>
+  static size_t WordCount(const L& logic, Unused...) { return logic.size(); }
+
+  size_t num_partitions_ = 0, words_per_partition_ = 0;
+  std::unique_ptr<Logic> logic_;
+  std::vector<word_t> words_;
+};
+
+// Blocked Bloom filter with blocks of one cache line, each key setting one
+// bit in each of their eight words.
+struct BloomFilter
+    : PartitionedFilter<dtl::blocked_bloomfilter_logic<uint32_t, dtl::hash::stat::mul32, uint64_t, 8, 8, 8,
+                                                       dtl::block_addressing::MAGIC>> {
+  static std::string name() { return "Bloom"; }
+};
+
+// Blocked cuckoo filter with blocks of one cache line and buckets of four
+// tags of tag_bits bits. It needs somewhat more than tag_bits bits per key:
+// buckets that overflow match every key.
+template <uint32_t tag_bits>
+struct CuckooFilter
+    : PartitionedFilter<dtl::blocked_cuckoofilter_logic<64, tag_bits, 4, dtl::block_addressing::MAGIC>> {
+  static std::string name() { return "Cuckoo" + std::to_string(tag_bits); }
+};
+
+// Index behind a filter of its keys, answering the lookups of keys the filter
+// rules out without reaching the index. params are those of Index followed
+// by the bits per key of the filter, which is sized for the bulk-loaded keys.
+// Deleted keys stay in the filter, which can not remove them.
+template <class KeyType, class Index, class Filter>
+class Filtered : public Base<KeyType> {
+ public:
+  Filtered(const std::vector<int>& params)
+      : index_(std::vector<int>(params.begin(), params.end() - 1)), bits_per_key_(params.back()) {}
+
+  uint64_t Build(const std::vector<KeyValue<KeyType>>& data, const size_t num_threads) {
+    const uint64_t build_time = index_.Build(data, num_threads) + util::timing([&] {
+      filter_.Init(data.size(), bits_per_key_);
+      for (const auto& kv: data){
+        filter_.insert(kv.key);
+      }
+    });
+    false_positive_rate_ = MeasureFalsePositives(data);
+    return build_time;
+  }
+
+  size_t EqualityLookup(const KeyType lookup_key, uint32_t thread_id) const {
+    if (!filter_.contains(lookup_key)){
+      return util::NOT_FOUND;
+    }
+    return index_.EqualityLookup(lookup_key, thread_id);
+  }
+
+  bool EqualityLookupBatch(const KeyType* lookup_keys, size_t n, size_t* out, uint32_t thread_id) const {
+    // Probe the filter for the whole batch first, then pass the keys it
+    // does not rule out on to the index as a smaller batch.
+    KeyType passed_keys[n];
+    size_t passed_pos[n], passed_out[n], m = 0;
+    for (size_t i = 0; i < n; ++i){
+      if (filter_.contains(lookup_keys[i])){
+        passed_keys[m] = lookup_keys[i];
+        passed_pos[m++] = i;
+      }
+      else{
+        out[i] = util::NOT_FOUND;
+      }
+    }
+    if (!index_.EqualityLookupBatch(passed_keys, m, passed_out, thread_id)){
+      for (size_t j = 0; j < m; ++j){
+        passed_out[j] = index_.EqualityLookup(passed_keys[j], thread_id);
+      }
+    }
+    for (size_t j = 0; j < m; ++j){
+      out[passed_pos[j]] = passed_out[j];
+    }
+    return true;
+  }
+
+  uint64_t RangeQuery(const KeyType lower_key, const KeyType upper_key, uint32_t thread_id) const {
+    return index_.RangeQuery(lower_key, upper_key, thread_id);
+  }
+
+  void Insert(const KeyValue<KeyType>& data, uint32_t thread_id) {
+    filter_.insert(data.key);
+    index_.Insert(data, thread_id);
+  }
+
+  void Delete(const KeyType& key, uint32_t thread_id) { index_.Delete(key, thread_id); }
+
+  void Update(const KeyValue<KeyType>& data, uint32_t thread_id) { index_.Update(data, thread_id); }
+
+  bool deletable() const { return index_.deletable(); }
+
+  std::string name() const { return "Filtered" + index_.name(); }
+
+  std::size_t size() const { return index_.size() + filter_.size(); }
+
+  // Filter inserts are not atomic, so concurrent inserts could lose keys.
+  bool applicable(bool unique, bool range_query, bool insert, bool multithread, const std::string& ops_filename) {
+    return !(insert && multithread) && index_.applicable(unique, range_query, insert, multithread, ops_filename);
+  }
+
+  bool concurrentReads() { return index_.concurrentReads(); }
+
+  bool forkable() const { return index_.forkable(); }
+
+  std::vector<std::string> variants() const {
+    std::vector<std::string> vec = index_.variants();
+    vec.push_back(Filter::name());
+    vec.push_back(std::to_string(bits_per_key_));
+    char fpr[32];
+    snprintf(fpr, sizeof(fpr), "%.6f", false_positive_rate_);
+    vec.push_back(fpr);
+    return vec;
+  }
+
+  double searchAverageTime() const { return index_.searchAverageTime(); }
+  double searchLatency(uint64_t op_cnt) const { return index_.searchLatency(op_cnt); }
+  double searchBound() const { return index_.searchBound(); }
+  void initSearch(size_t num_threads) { index_.initSearch(num_threads); }
+  SearchStats* searchStats(uint32_t thread_id) { return index_.searchStats(thread_id); }
+  void initThread(uint32_t thread_id) { index_.initThread(thread_id); }
+  void exitThread(uint32_t thread_id) { index_.exitThread(thread_id); }
+
+ private:
+  // Share of absent keys, drawn uniformly between the smallest and the
+  // largest key, that the built filter lets through.
+  double MeasureFalsePositives(const std::vector<KeyValue<KeyType>>& data) const {
+    if constexpr (!std::is_integral<KeyType>::value){
+      return 0;
+    }
+    else{
+      if (data.empty()){
+        return 0;
+      }
+      util::FastRandom ranny(42);
+      const KeyType min_key = data.front().key, max_key = data.back().key;
+      size_t absent = 0, passed = 0;
+      for (size_t i = 0; i < kProbes; ++i){
+        const KeyType key = min_key + KeyType(ranny.ScaleFactor() * (max_key - min_key));
+        const auto it = std::lower_bound(data.begin(), data.end(), key,
+            [](const KeyValue<KeyType>& kv, const KeyType& k) { return kv.key < k; });
+        if (it != data.end() && it->key == key){
+          continue;
+        }
+        ++absent;
+        passed += filter_.contains(key);
+      }
+      return absent ? double(passed) / absent : 0;
+    }
+  }
+
+  static constexpr size_t kProbes = 1 << 16;
+
+  Index index_;
+  Filter filter_;
+  const size_t bits_per_key_;
+  double false_positive_rate_ = 0;
+};
@@ -7,6 +7,7 @@
 #include <vector>
 
 #include "../util.h"
+#include "../utils/projection.h"
 #include "base.h"
 #include "finedex/include/aidel.h"
 #include "finedex/include/aidel_impl.h"
@@ -26,18 +27,14 @@ class FINEdex : public Competitor<KeyType, SearchClass> {
   }
 
   uint64_t Build(const std::vector<KeyValue<KeyType>>& data, size_t num_threads) {
-    std::vector<KeyType> keys;
-    std::vector<uint64_t> values;
-    for (const KeyValue<KeyType>& kv : data) {
-      keys.push_back(kv.key);
-      values.push_back(kv.value);
-    }
+    const auto keys = util::keys_of(data);
+    const auto values = util::values_of(data);
 
     num_workers_ = num_threads;
 
     uint64_t build_time =
         util::timing([&] { 
-          table->train(keys, values, max_error);
+          table->train(keys.begin(), values.begin(), data.size(), max_error);
     });
 
     return build_time;
@@ -66,6 +63,16 @@ class FINEdex : public Competitor<KeyType, SearchClass> {
     table->insert(data.key, data.value);
   }
 
+  void Delete(const KeyType& key, uint32_t thread_id) {
+    table->remove(key);
+  }
+
+  void Update(const KeyValue<KeyType>& data, uint32_t thread_id) {
+    table->update(data.key, data.value);
+  }
+
+  bool deletable() const { return true; }
+
   std::string name() const { return "FINEdex"; }
 
   std::size_t size() const { return table->size(); }
@@ -81,37 +88,6 @@ class FINEdex : public Competitor<KeyType, SearchClass> {
     return vec;
   }
 
-  uint64_t runMultithread(void *(* func)(void *), FGParam *params) {
-    pthread_t threads[num_workers_];
-
-    for (size_t worker_i = 0; worker_i < num_workers_; worker_i++) {
-      int ret = pthread_create(&threads[worker_i], nullptr, func,
-                              (void *)&params[worker_i]);
-      if (ret) {
-        std::cout << "Error: " << ret << std::endl;
-      }
-    }
-
-    std::cout << "[micro] prepare data ...\n";
-    while (util::ready_threads < num_workers_) sleep(1);
-    util::running = true;
-
-    uint64_t timing = util::timing([&] {
-      while (util::running)
-        ;
-    });
-
-    void *status;
-    for (size_t i = 0; i < num_workers_; i++) {
-      int rc = pthread_join(threads[i], &status);
-      if (rc) {
-        std::cout << "Error:unable to join, " << rc << std::endl;
-      }
-    }
-    
-    return timing;
-  }
-
  private:
   aidel_type* table;
   size_t num_workers_;
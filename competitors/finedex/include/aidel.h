@@ -23,6 +23,8 @@ public:
     inline AIDEL(int _maxErr, int _learning_step, float _learning_rate);
     ~AIDEL();
     void train(const std::vector<key_t> &keys, const std::vector<val_t> &vals, size_t _maxErr);
+    template<class KeyIt, class ValIt>
+    void train(KeyIt keys, ValIt vals, size_t size, size_t _maxErr);
     void train_opt(const std::vector<key_t> &keys, const std::vector<val_t> &vals, size_t _maxErr);
     //void retrain(typename root_type::iterator it);
     void print_models();
@@ -40,11 +42,10 @@ public:
 
 
 private:
-    size_t backward_train(const typename std::vector<key_t>::const_iterator &keys_begin,
-                          const typename std::vector<val_t>::const_iterator &vals_begin, 
-                          uint32_t size, int step);
-    void append_model(lrmodel_type &model, const typename std::vector<key_t>::const_iterator &keys_begin, 
-                      const typename std::vector<val_t>::const_iterator &vals_begin, 
+    template<class KeyIt, class ValIt>
+    size_t backward_train(KeyIt keys_begin, ValIt vals_begin, uint32_t size, int step);
+    template<class KeyIt, class ValIt>
+    void append_model(lrmodel_type &model, KeyIt keys_begin, ValIt vals_begin, 
                       size_t size, int err);
     aidelmodel_type* find_model(const key_t &key);
     int locate_in_levelbin(key_t key, int model_pos);
@@ -37,37 +37,46 @@ void AIDEL<key_t, val_t, SearchClass>::train(const std::vector<key_t> &keys,
                                 const std::vector<val_t> &vals, size_t _maxErr)
 {
     assert(keys.size() == vals.size());
+    train(keys.begin(), vals.begin(), keys.size(), _maxErr);
+}
+
+// Trains on `size` sorted keys and their values, read through random access
+// iterators; each model copies its own range.
+template<class key_t, class val_t, class SearchClass>
+template<class KeyIt, class ValIt>
+void AIDEL<key_t, val_t, SearchClass>::train(KeyIt keys, ValIt vals, size_t size, size_t _maxErr)
+{
     maxErr = _maxErr;
-    std::cout<<"training begin, length of training_data is:" << keys.size() <<" ,maxErr: "<< maxErr << std::endl;
+    std::cout<<"training begin, length of training_data is:" << size <<" ,maxErr: "<< maxErr << std::endl;
 
     size_t start = 0;
-    size_t end = learning_step<keys.size()?learning_step:keys.size();
+    size_t end = learning_step<size?learning_step:size;
     while(start<end){
         //COUT_THIS("start:" << start<<" ,end: "<<end);
         lrmodel_type model;
-        model.train(keys.begin()+start, end-start);
+        model.train(keys+start, end-start);
         size_t err = model.get_maxErr();
         // equal
         if(err == maxErr) {
-            append_model(model, keys.begin()+start, vals.begin()+start, end-start, err);
+            append_model(model, keys+start, vals+start, end-start, err);
         } else if(err < maxErr) {
-            if(end>=keys.size()){
-                append_model(model, keys.begin()+start, vals.begin()+start, end-start, err);
+            if(end>=size){
+                append_model(model, keys+start, vals+start, end-start, err);
                 break;
             }
             end += learning_step;
-            if(end>keys.size()){
-                end = keys.size();
+            if(end>size){
+                end = size;
             }
             continue;
         } else {
-            size_t offset = backward_train(keys.begin()+start, vals.begin()+start, end-start, std::max(int(learning_step*learning_rate), 1));
+            size_t offset = backward_train(keys+start, vals+start, end-start, std::max(int(learning_step*learning_rate), 1));
 			end = start + offset;
         }
         start = end;
         end += learning_step;
-        if(end>=keys.size()){
-            end = keys.size();
+        if(end>=size){
+            end = size;
         }
     }
 
@@ -77,8 +86,8 @@ void AIDEL<key_t, val_t, SearchClass>::train(const std::vector<key_t> &keys,
 }
 
 template<class key_t, class val_t, class SearchClass>
-size_t AIDEL<key_t, val_t, SearchClass>::backward_train(const typename std::vector<key_t>::const_iterator &keys_begin, 
-                                           const typename std::vector<val_t>::const_iterator &vals_begin,
+template<class KeyIt, class ValIt>
+size_t AIDEL<key_t, val_t, SearchClass>::backward_train(KeyIt keys_begin, ValIt vals_begin,
                                            uint32_t size, int step)
 {
     if(size<=10){
@@ -110,9 +119,9 @@ size_t AIDEL<key_t, val_t, SearchClass>::backward_train(const typename std::vect
 }
 
 template<class key_t, class val_t, class SearchClass>
+template<class KeyIt, class ValIt>
 void AIDEL<key_t, val_t, SearchClass>::append_model(lrmodel_type &model, 
-                                       const typename std::vector<key_t>::const_iterator &keys_begin, 
-                                       const typename std::vector<val_t>::const_iterator &vals_begin, 
+                                       KeyIt keys_begin, ValIt vals_begin, 
                                        size_t size, int err)
 {
     key_t key = *(keys_begin+size-1);
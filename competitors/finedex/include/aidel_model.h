@@ -38,8 +38,8 @@ public:
 public:
     inline AidelModel();
     ~AidelModel();
-    AidelModel(lrmodel_type &lrmodel, const typename std::vector<key_t>::const_iterator &keys_begin,
-               const typename std::vector<val_t>::const_iterator &vals_begin, 
+    template<class KeyIt, class ValIt>
+    AidelModel(lrmodel_type &lrmodel, KeyIt keys_begin, ValIt vals_begin, 
                size_t size, size_t _maxErr);
     inline size_t get_capacity();
     inline void print_model();
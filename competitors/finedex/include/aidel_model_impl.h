@@ -53,9 +53,9 @@ void AidelModel<key_t, val_t, SearchClass>::clear()
 }
 
 template<class key_t, class val_t, class SearchClass>
+template<class KeyIt, class ValIt>
 AidelModel<key_t, val_t, SearchClass>::AidelModel(lrmodel_type &lrmodel, 
-                                     const typename std::vector<key_t>::const_iterator &keys_begin, 
-                                     const typename std::vector<val_t>::const_iterator &vals_begin, 
+                                     KeyIt keys_begin, ValIt vals_begin, 
                                      size_t size, size_t _maxErr) : maxErr(_maxErr), capacity(size)
 {
     model=new lrmodel_type(lrmodel.get_weight0(), lrmodel.get_weight1());
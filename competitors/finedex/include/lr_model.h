@@ -16,7 +16,8 @@ public:
     inline LinearRegressionModel();
     inline LinearRegressionModel(double w, double b);
     ~LinearRegressionModel();
-    void train(const typename std::vector<key_t>::const_iterator &it, size_t size);
+    template<class KeyIt>
+    void train(KeyIt it, size_t size);
     void train(const std::vector<key_t> &keys,
                const std::vector<size_t> &positions);
     void print_weights() const;
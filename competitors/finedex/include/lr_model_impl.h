@@ -20,7 +20,8 @@ LinearRegressionModel<key_t>::~LinearRegressionModel(){}
 
 
 template<class key_t>
-void LinearRegressionModel<key_t>::train(const typename std::vector<key_t>::const_iterator &it, size_t size)
+template<class KeyIt>
+void LinearRegressionModel<key_t>::train(KeyIt it, size_t size)
 {
     std::vector<key_t> trainkeys(size);
     std::vector<size_t> positions(size);
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../utils/projection.h"
 #include "./lipp/src/core/lipp.h"
 #include "base.h"
 
@@ -9,14 +10,10 @@ class Lipp: public Base<KeyType>
 public:
     Lipp(const std::vector<int>& params){}
     uint64_t Build(const std::vector<KeyValue<KeyType>>& data, size_t num_threads) {
-        std::vector<std::pair<KeyType, uint64_t>> loading_data;
-        loading_data.reserve(data.size());
-        for (const auto& itm : data) {
-            loading_data.push_back(std::make_pair(itm.key, itm.value));
-        }
-
+        const auto keys = util::keys_of(data);
+        const auto values = util::values_of(data);
         return util::timing(
-            [&] { lipp_.bulk_load(loading_data.data(), loading_data.size()); });
+            [&] { lipp_.bulk_load(keys.begin(), values.begin(), data.size(), num_threads); });
     }
 
     size_t EqualityLookup(const KeyType& lookup_key, uint32_t thread_id) const {
@@ -41,6 +38,8 @@ public:
         lipp_.insert(data.key, data.value);
     }
 
+    bool concurrentReads() { return true; }
+
     bool applicable(bool unique, bool range_query, bool insert, bool multithread, const std::string& ops_filename) {
         // LIPP only supports unique keys.
         return unique && !multithread;
@@ -4,9 +4,11 @@
 #include "lipp_base.h"
 #include <stdint.h>
 #include <math.h>
+#include <atomic>
 #include <limits>
 #include <cstdio>
 #include <stack>
+#include <thread>
 #include <vector>
 #include <cstring>
 #include <sstream>
@@ -65,8 +67,8 @@ class LIPP
     const bool QUIET;
 
     struct {
-        long long fmcd_success_times = 0;
-        long long fmcd_broken_times = 0;
+        std::atomic<long long> fmcd_success_times{0};
+        std::atomic<long long> fmcd_broken_times{0};
         #if COLLECT_TIME
         double time_scan_and_destory_tree = 0;
         double time_build_tree_bulk = 0;
@@ -144,7 +146,7 @@ public:
             }
         }
     }
-    void bulk_load(const V* vs, int num_keys) {
+    void bulk_load(const V* vs, int num_keys, size_t num_threads = 1) {
         if (num_keys == 0) {
             destroy_tree(root);
             root = build_tree_none();
@@ -174,10 +176,30 @@ public:
             values[i] = vs[i].second;
         }
         destroy_tree(root);
-        root = build_tree_bulk(keys, values, num_keys);
+        root = build_tree_bulk(keys, values, num_keys, num_threads);
         delete[] keys;
         delete[] values;
     }
+    /// bulk load from separate random access iterators over the sorted keys
+    /// and their values, which are read in place.
+    template<class KeyIt, class ValueIt>
+    void bulk_load(KeyIt keys, ValueIt values, int num_keys, size_t num_threads) {
+        if (num_keys <= 2) {
+            destroy_tree(root);
+            root = build_tree_none();
+            for (int i = 0; i < num_keys; i ++) {
+                insert(keys[i], values[i]);
+            }
+            return;
+        }
+
+        for (int i = 1; i < num_keys; i ++) {
+            RT_ASSERT(keys[i] > keys[i-1]);
+        }
+
+        destroy_tree(root);
+        root = build_tree_bulk(keys, values, num_keys, num_threads);
+    }
 
     void show() const {
         printf("============= SHOW LIPP ================\n");
@@ -255,8 +277,8 @@ public:
     void print_stats() const {
         printf("======== Stats ===========\n");
         if (USE_FMCD) {
-            printf("\t fmcd_success_times = %lld\n", stats.fmcd_success_times);
-            printf("\t fmcd_broken_times = %lld\n", stats.fmcd_broken_times);
+            printf("\t fmcd_success_times = %lld\n", stats.fmcd_success_times.load());
+            printf("\t fmcd_broken_times = %lld\n", stats.fmcd_broken_times.load());
         }
         #if COLLECT_TIME
         printf("\t time_scan_and_destory_tree = %lf\n", stats.time_scan_and_destory_tree);
@@ -322,6 +344,13 @@ private:
     Node* root;
     std::stack<Node*> pending_two;
 
+    struct Segment {
+        int begin;
+        int end;
+        int level; // top level = 1
+        Node* node;
+    };
+
     std::allocator<Node> node_allocator;
     Node* new_nodes(int n)
     {
@@ -438,26 +467,55 @@ private:
         return node;
     }
     /// bulk build, _keys must be sorted in asc order.
-    Node* build_tree_bulk(T* _keys, P* _values, int _size)
+    /// with several threads, the root is built first and the subtrees below
+    /// it are then built concurrently, each from its own key range.
+    template<class KeyIt, class ValueIt>
+    Node* build_tree_bulk(KeyIt _keys, ValueIt _values, int _size, size_t num_threads = 1)
     {
-        if (USE_FMCD) {
-            return build_tree_bulk_fmcd(_keys, _values, _size);
-        } else {
-            return build_tree_bulk_fast(_keys, _values, _size);
+        if (num_threads <= 1) {
+            if (USE_FMCD) {
+                return build_tree_bulk_fmcd(_keys, _values, _size);
+            } else {
+                return build_tree_bulk_fast(_keys, _values, _size);
+            }
+        }
+
+        // build_tree_two() reuses pending nodes, which is not thread-safe.
+        destory_pending();
+
+        std::vector<Segment> children;
+        Node* ret = USE_FMCD ? build_tree_bulk_fmcd(_keys, _values, _size, &children)
+                             : build_tree_bulk_fast(_keys, _values, _size, &children);
+
+        std::atomic<size_t> next_child(0);
+        auto build_children = [&]() {
+            for (size_t i = next_child++; i < children.size(); i = next_child++) {
+                const Segment& child = children[i];
+                Node* _ = build_tree_bulk(_keys + child.begin, _values + child.begin, child.end - child.begin);
+                memcpy(child.node, _, sizeof(Node));
+                delete_nodes(_, 1);
+            }
+        };
+        std::vector<std::thread> workers;
+        for (size_t t = 1; t < num_threads; t ++) {
+            workers.emplace_back(build_children);
+        }
+        build_children();
+        for (auto& worker : workers) {
+            worker.join();
         }
+
+        return ret;
     }
     /// bulk build, _keys must be sorted in asc order.
     /// split keys into three parts at each node.
-    Node* build_tree_bulk_fast(T* _keys, P* _values, int _size)
+    /// if children is given, only the root is built and the segments of its
+    /// children are returned there instead.
+    template<class KeyIt, class ValueIt>
+    Node* build_tree_bulk_fast(KeyIt _keys, ValueIt _values, int _size, std::vector<Segment>* children = NULL)
     {
         RT_ASSERT(_size > 1);
 
-        typedef struct {
-            int begin;
-            int end;
-            int level; // top level = 1
-            Node* node;
-        } Segment;
         std::stack<Segment> s;
 
         Node* ret = new_nodes(1);
@@ -476,8 +534,8 @@ private:
                 memcpy(node, _, sizeof(Node));
                 delete_nodes(_, 1);
             } else {
-                T* keys = _keys + begin;
-                P* values = _values + begin;
+                KeyIt keys = _keys + begin;
+                ValueIt values = _values + begin;
                 const int size = end - begin;
                 const int BUILD_GAP_CNT = compute_gap_count(size);
 
@@ -542,7 +600,12 @@ private:
                         BITMAP_CLEAR(node->none_bitmap, item_i);
                         BITMAP_SET(node->child_bitmap, item_i);
                         node->items[item_i].comp.child = new_nodes(1);
-                        s.push((Segment){begin + offset, begin + next, level + 1, node->items[item_i].comp.child});
+                        const Segment child = {begin + offset, begin + next, level + 1, node->items[item_i].comp.child};
+                        if (children != NULL) {
+                            children->push_back(child);
+                        } else {
+                            s.push(child);
+                        }
                     }
                     if (next >= size) {
                         break;
@@ -558,16 +621,13 @@ private:
     }
     /// bulk build, _keys must be sorted in asc order.
     /// FMCD method.
-    Node* build_tree_bulk_fmcd(T* _keys, P* _values, int _size)
+    /// if children is given, only the root is built and the segments of its
+    /// children are returned there instead.
+    template<class KeyIt, class ValueIt>
+    Node* build_tree_bulk_fmcd(KeyIt _keys, ValueIt _values, int _size, std::vector<Segment>* children = NULL)
     {
         RT_ASSERT(_size > 1);
 
-        typedef struct {
-            int begin;
-            int end;
-            int level; // top level = 1
-            Node* node;
-        } Segment;
         std::stack<Segment> s;
 
         Node* ret = new_nodes(1);
@@ -586,8 +646,8 @@ private:
                 memcpy(node, _, sizeof(Node));
                 delete_nodes(_, 1);
             } else {
-                T* keys = _keys + begin;
-                P* values = _values + begin;
+                KeyIt keys = _keys + begin;
+                ValueIt values = _values + begin;
                 const int size = end - begin;
                 const int BUILD_GAP_CNT = compute_gap_count(size);
 
@@ -692,7 +752,12 @@ private:
                         BITMAP_CLEAR(node->none_bitmap, item_i);
                         BITMAP_SET(node->child_bitmap, item_i);
                         node->items[item_i].comp.child = new_nodes(1);
-                        s.push((Segment){begin + offset, begin + next, level + 1, node->items[item_i].comp.child});
+                        const Segment child = {begin + offset, begin + next, level + 1, node->items[item_i].comp.child};
+                        if (children != NULL) {
+                            children->push_back(child);
+                        } else {
+                            s.push(child);
+                        }
                     }
                     if (next >= size) {
                         break;
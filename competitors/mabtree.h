@@ -2,6 +2,7 @@
 
 #include "./MADEX/src/mabtree.h"
 
+#include "../utils/projection.h"
 #include "../utils/tracking_allocator.h"
 #include "base.h"
 
@@ -12,15 +13,9 @@ class MABTree : public Competitor<KeyType, SearchClass> {
       : btree_(TrackingAllocator<std::pair<KeyType, uint64_t>>(
             total_allocation_size)) {}
   uint64_t Build(const std::vector<KeyValue<KeyType>>& data, const size_t num_threads) {
-    std::vector<std::pair<KeyType, uint64_t>> reformatted_data;
-    reformatted_data.reserve(data.size());
-
-    for (const auto& iter : data) {
-      reformatted_data.emplace_back(iter.key, iter.value);
-    }
-
+    const auto pairs = util::pairs_of(data);
     return util::timing([&] {
-      btree_.bulk_load(reformatted_data.begin(), reformatted_data.end());
+      btree_.bulk_load(pairs.begin(), pairs.end(), num_threads);
     });
   }
 
@@ -51,6 +46,20 @@ class MABTree : public Competitor<KeyType, SearchClass> {
     btree_.insert2(data.key, data.value);
   }
 
+  void Delete(const KeyType& key, uint32_t thread_id) {
+    btree_.erase_one(key);
+  }
+
+  void Update(const KeyValue<KeyType>& data, uint32_t thread_id) {
+    auto it = btree_.find(data.key);
+    if (it != btree_.end()) {
+      // operator-> points to a copy of the pair.
+      it.data() = data.value;
+    }
+  }
+
+  bool deletable() const { return true; }
+
   std::vector<std::string> variants() const { 
     std::vector<std::string> vec;
     vec.push_back(SearchClass::name());
@@ -61,6 +70,8 @@ class MABTree : public Competitor<KeyType, SearchClass> {
 
   std::string name() const { return "MABTree"; }
 
+  bool concurrentReads() { return true; }
+
   bool applicable(bool unique, bool range_query, bool insert, bool multithread, const std::string& ops_filename) const {
     // The last several keys of AlexNode's key_slots_ are std::numeric_limits<KeyType>::max()
     return SearchClass::name() != "InterpolationSearch" && !multithread;
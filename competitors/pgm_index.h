@@ -9,38 +9,37 @@
 #include "../util.h"
 #include "base.h"
 #include "pgm_index.hpp"
+#include "soa_data.h"
 
 template <class KeyType, class SearchClass, size_t pgm_error>
 class PGM : public Competitor<KeyType, SearchClass> {
  public:
   PGM(const std::vector<int>& params){}
   uint64_t Build(const std::vector<KeyValue<KeyType>>& data, const size_t num_threads) {
-    std::vector<KeyType> keys;
-    keys.reserve(data.size());
-    std::transform(data.begin(), data.end(), std::back_inserter(keys),
-                   [](const KeyValue<KeyType>& kv) { return kv.key; });
-
     uint64_t build_time = util::timing([&] { 
-          data_ = data;
-          pgm_ = decltype(pgm_)(keys.begin(), keys.end()); 
+          data_.Assign(data);
+          pgm_ = decltype(pgm_)(data_.keys(), data_.keys() + data_.size()); 
         });
 
     return build_time;
   }
 
   size_t EqualityLookup(const KeyType lookup_key, uint32_t thread_id) const {
-    auto approx_range = pgm_.find_approximate_position(lookup_key);
-    auto pos = approx_range.pos;
-    auto lo = approx_range.lo;
-    auto hi = approx_range.hi;
-    typedef typename std::vector<KeyValue<KeyType>>::const_iterator Iterator;
-    auto it = SearchClass::lower_bound(data_.begin() + lo, data_.begin() + hi, lookup_key,  
-                      data_.begin() + pos, std::function<KeyType(Iterator)>([](Iterator it)->KeyType {
-                                                      return it->key; }));
-    if (it == data_.end() || it->key != lookup_key){
-      return util::OVERFLOW;
+    return LastMileSearch(lookup_key, pgm_.find_approximate_position(lookup_key));
+  }
+
+  bool EqualityLookupBatch(const KeyType* lookup_keys, size_t n, size_t* out, uint32_t thread_id) const {
+    // Evaluate all models first and prefetch the predicted positions,
+    // so that the last-mile searches of the batch overlap their misses.
+    ApproxPos approx_ranges[n];
+    for (size_t i = 0; i < n; ++i){
+      approx_ranges[i] = pgm_.find_approximate_position(lookup_keys[i]);
+      data_.Prefetch(approx_ranges[i].pos);
     }
-    return it - data_.begin();
+    for (size_t i = 0; i < n; ++i){
+      out[i] = LastMileSearch(lookup_keys[i], approx_ranges[i]);
+    }
+    return true;
   }
 
   uint64_t RangeQuery(const KeyType lower_key, const KeyType upper_key, uint32_t thread_id) const {
@@ -48,28 +47,38 @@ class PGM : public Competitor<KeyType, SearchClass> {
     auto pos = approx_range.pos;
     auto lo = approx_range.lo;
     auto hi = approx_range.hi;
-    typedef typename std::vector<KeyValue<KeyType>>::const_iterator Iterator;
-    auto it = SearchClass::lower_bound(data_.begin() + lo, data_.begin() + hi, lower_key,  
-                      data_.begin() + pos, std::function<KeyType(Iterator)>([](Iterator it)->KeyType {
-                                                      return it->key; }));
-    while(it != data_.end() && it->key < lower_key){
+    auto it = SearchClass::lower_bound(data_.keys() + lo, data_.keys() + hi, lower_key, data_.keys() + pos);
+    while(it != data_.keys_end() && *it < lower_key){
       ++it;
     }
-    uint64_t result = 0;
-    while(it != data_.end() && it->key <= upper_key){
-      result += it->value;
-      ++it;
+    return data_.SumUpTo(it - data_.keys(), upper_key);
+  }
+
+  bool Save(const std::string& filename) const {
+    util::SnapshotWriter snapshot(sizeof(KeyType));
+    data_.Save(snapshot);
+    pgm_.save(snapshot);
+    return snapshot.Write(filename);
+  }
+
+  bool Load(const std::string& filename) {
+    util::SnapshotReader snapshot;
+    if (!snapshot.Open(filename, sizeof(KeyType))){
+      return false;
     }
-    return result;
+    data_.Load(snapshot);
+    pgm_.load(snapshot);
+    return true;
   }
 
   std::string name() const { return "PGM"; }
 
   std::size_t size() const { return pgm_.size_in_bytes() + (sizeof(KeyType) + sizeof(uint64_t)) * data_.size(); }
 
+  bool concurrentReads() { return true; }
+
   bool applicable(bool unique, bool range_query, bool insert, bool multithread, const std::string& ops_filename) const {
-    std::string name = SearchClass::name();
-    return !insert && name != "LinearAVX" && !multithread;
+    return !insert && !multithread;
   }
 
   std::vector<std::string> variants() const { 
@@ -80,8 +89,14 @@ class PGM : public Competitor<KeyType, SearchClass> {
   }
 
  private:
+  size_t LastMileSearch(const KeyType lookup_key, const ApproxPos& approx_range) const {
+    auto it = SearchClass::lower_bound(data_.keys() + approx_range.lo, data_.keys() + approx_range.hi, lookup_key,  
+                      data_.keys() + approx_range.pos);
+    return data_.Find(it, lookup_key);
+  }
+
   PGMIndex<KeyType, SearchClass, pgm_error, 4> pgm_;
-  std::vector<KeyValue<KeyType>> data_;
+  SoAData<KeyType> data_;
 };
 
 #endif  // TLI_PGM_H
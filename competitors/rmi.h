@@ -4,12 +4,13 @@
 
 #include "base.h"
 #include "rmi/all_rmis.h"
+#include "soa_data.h"
 
 //#define DEBUG_RMI
 
 // RMI with binary search
 template <class KeyType, class SearchClass, int rmi_variant, uint64_t build_time, size_t rmi_size,
-          const char* namespc, uint64_t (*RMI_FUNC)(uint64_t, size_t*),
+          const char* namespc, uint64_t (*RMI_FUNC)(KeyType, size_t*),
           bool (*RMI_LOAD)(char const*), void (*RMI_CLEANUP)()>
 class RMI_B: public Competitor<KeyType, SearchClass> {
  public:
@@ -25,7 +26,7 @@ class RMI_B: public Competitor<KeyType, SearchClass> {
     }
 
     return build_time + util::timing([&] {
-      data_ = data;
+      data_.Assign(data);
     });
   }
 
@@ -36,14 +37,29 @@ class RMI_B: public Competitor<KeyType, SearchClass> {
     uint64_t start = (guess < error ? 0 : guess - error);
     uint64_t stop = (guess + error >= data_.size() ? data_.size() : guess + error);
 
-    typedef typename std::vector<KeyValue<KeyType>>::const_iterator Iterator;
-    auto it = SearchClass::lower_bound(data_.begin() + start, data_.begin() + stop, lookup_key,  
-                      data_.begin() + guess, std::function<KeyType(Iterator)>([](Iterator it)->KeyType {
-                                                      return it->key; }));
-    if (it == data_.end() || it->key != lookup_key){
-      return util::OVERFLOW;
+    auto it = SearchClass::lower_bound(data_.keys() + start, data_.keys() + stop, lookup_key,  
+                      data_.keys() + guess);
+    return data_.Find(it, lookup_key);
+  }
+
+  bool EqualityLookupBatch(const KeyType* lookup_keys, size_t n, size_t* out, uint32_t thread_id) const {
+    // Evaluate all models first and prefetch the guesses,
+    // so that the last-mile searches of the batch overlap their misses.
+    uint64_t guesses[n];
+    size_t errors[n];
+    for (size_t i = 0; i < n; ++i){
+      guesses[i] = RMI_FUNC(lookup_keys[i], &errors[i]);
+      data_.Prefetch(guesses[i]);
+    }
+
+    for (size_t i = 0; i < n; ++i){
+      uint64_t start = (guesses[i] < errors[i] ? 0 : guesses[i] - errors[i]);
+      uint64_t stop = (guesses[i] + errors[i] >= data_.size() ? data_.size() : guesses[i] + errors[i]);
+      auto it = SearchClass::lower_bound(data_.keys() + start, data_.keys() + stop, lookup_keys[i],  
+                        data_.keys() + guesses[i]);
+      out[i] = data_.Find(it, lookup_keys[i]);
     }
-    return it - data_.begin();
+    return true;
   }
 
   uint64_t RangeQuery(const KeyType lower_key, const KeyType upper_key, uint32_t thread_id) const {
@@ -52,20 +68,15 @@ class RMI_B: public Competitor<KeyType, SearchClass> {
     uint64_t start = (guess < error ? 0 : guess - error);
     uint64_t stop = (guess + error >= data_.size() ? data_.size() : guess + error);
 
-    typedef typename std::vector<KeyValue<KeyType>>::const_iterator Iterator;
-    auto it = SearchClass::lower_bound(data_.begin() + start, data_.begin() + stop, lower_key,  
-                      data_.begin() + guess, std::function<KeyType(Iterator)>([](Iterator it)->KeyType {
-                                                      return it->key; }));
-    uint64_t result = 0;
-    while(it != data_.end() && it->key <= upper_key){
-      result += it->value;
-      ++it;
-    }
-    return result;
+    auto it = SearchClass::lower_bound(data_.keys() + start, data_.keys() + stop, lower_key,  
+                      data_.keys() + guess);
+    return data_.SumUpTo(it - data_.keys(), upper_key);
   }
 
+  bool concurrentReads() { return true; }
+
   bool applicable(bool unique, bool range_query, bool insert, bool multithread, const std::string& ops_filename) const {
-    return !insert && ops_filename.find("books_200M_uint32") == std::string::npos && !multithread;
+    return !insert && !multithread;
   }
 
   std::vector<std::string> variants() const { 
@@ -82,5 +93,5 @@ class RMI_B: public Competitor<KeyType, SearchClass> {
   ~RMI_B() { RMI_CLEANUP(); }
 
  private:
-  std::vector<KeyValue<KeyType>> data_;
+  SoAData<KeyType> data_;
 };
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "../util.h"
+#include "base.h"
+#include "rmi_native/builder.h"
+#include "rmi_native/rmi.h"
+#include "soa_data.h"
+
+// RMI trained in-process: params are the root type (0: linear, 1: cubic,
+// 2: radix, 3: linear spline) and the log2 of the number of leaves.
+template <class KeyType, class SearchClass>
+class RMINative : public Competitor<KeyType, SearchClass> {
+ public:
+  RMINative(const std::vector<int>& params)
+      : root_type_(static_cast<rmi_native::RootType>(params[0])),
+        num_leaves_log_(params[1]) {}
+
+  uint64_t Build(const std::vector<KeyValue<KeyType>>& data, const size_t num_threads) {
+    return util::timing([&] {
+      data_.Assign(data);
+
+      rmi_native::Builder<KeyType> rmib(root_type_, num_leaves_log_);
+      rmi_ = rmib.Build(data_.keys(), data_.size(), num_threads);
+    });
+  }
+
+  size_t EqualityLookup(const KeyType lookup_key, uint32_t thread_id) const {
+    const rmi_native::SearchBound sb = rmi_.GetSearchBound(lookup_key);
+    auto it = SearchClass::lower_bound(data_.keys() + sb.begin, data_.keys() + sb.end, lookup_key,
+                      data_.keys() + sb.pos);
+    return data_.Find(it, lookup_key);
+  }
+
+  bool EqualityLookupBatch(const KeyType* lookup_keys, size_t n, size_t* out, uint32_t thread_id) const {
+    // Evaluate all models first and prefetch the predicted positions,
+    // so that the last-mile searches of the batch overlap their misses.
+    rmi_native::SearchBound sbs[n];
+    for (size_t i = 0; i < n; ++i){
+      sbs[i] = rmi_.GetSearchBound(lookup_keys[i]);
+      data_.Prefetch(sbs[i].pos);
+    }
+    for (size_t i = 0; i < n; ++i){
+      auto it = SearchClass::lower_bound(data_.keys() + sbs[i].begin, data_.keys() + sbs[i].end, lookup_keys[i],
+                        data_.keys() + sbs[i].pos);
+      out[i] = data_.Find(it, lookup_keys[i]);
+    }
+    return true;
+  }
+
+  uint64_t RangeQuery(const KeyType lower_key, const KeyType upper_key, uint32_t thread_id) const {
+    const rmi_native::SearchBound sb = rmi_.GetSearchBound(lower_key);
+    auto it = SearchClass::lower_bound(data_.keys() + sb.begin, data_.keys() + sb.end, lower_key,
+                      data_.keys() + sb.pos);
+    return data_.SumUpTo(it - data_.keys(), upper_key);
+  }
+
+  bool Save(const std::string& filename) const {
+    util::SnapshotWriter snapshot(sizeof(KeyType));
+    data_.Save(snapshot);
+    rmi_.Save(snapshot);
+    return snapshot.Write(filename);
+  }
+
+  bool Load(const std::string& filename) {
+    util::SnapshotReader snapshot;
+    if (!snapshot.Open(filename, sizeof(KeyType))){
+      return false;
+    }
+    data_.Load(snapshot);
+    rmi_.Load(snapshot);
+    return true;
+  }
+
+  std::string name() const { return "RMINative"; }
+
+  std::size_t size() const { return rmi_.GetSize() + (sizeof(KeyType) + sizeof(uint64_t)) * data_.size(); }
+
+  bool concurrentReads() { return true; }
+
+  bool applicable(bool unique, bool range_query, bool insert, bool multithread, const std::string& ops_filename) const {
+    return !insert && !multithread;
+  }
+
+  std::vector<std::string> variants() const {
+    std::vector<std::string> vec;
+    vec.push_back(SearchClass::name());
+    vec.push_back(rmi_native::RootName(root_type_));
+    vec.push_back(std::to_string(num_leaves_log_));
+    return vec;
+  }
+
+ private:
+  const rmi_native::RootType root_type_;
+  const size_t num_leaves_log_;
+  rmi_native::RMI<KeyType> rmi_;
+  SoAData<KeyType> data_;
+};
@@ -0,0 +1,260 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <thread>
+#include <vector>
+
+#include "common.h"
+#include "rmi.h"
+
+namespace rmi_native {
+
+// Trains a two-layer `RMI` over a dense array of sorted keys.
+template <class KeyType>
+class Builder {
+ public:
+  // `num_leaves_log` is the log2 of the number of leaves; a radix root may use
+  // fewer leaves if the key range needs fewer bits.
+  Builder(RootType root_type, size_t num_leaves_log)
+      : root_type_(root_type), num_leaves_log_(num_leaves_log) {}
+
+  // Trains the root on a sample of the keys, then the leaves in parallel,
+  // each on the keys the root assigns to it.
+  RMI<KeyType> Build(const KeyType* keys, size_t num_keys, size_t num_threads) {
+    RootModel<KeyType> root = TrainRoot(root_type_, keys, num_keys);
+    std::vector<Leaf> leaves;
+    if (!TrainLeaves(root, keys, num_keys, num_threads, leaves)) {
+      // Rounding made the cubic root decrease somewhere, so that a leaf does
+      // not hold a contiguous key range. Fall back to a linear spline.
+      root = TrainRoot(RootType::LinearSpline, keys, num_keys);
+      TrainLeaves(root, keys, num_keys, num_threads, leaves);
+    }
+    return RMI<KeyType>(root, std::move(leaves), num_keys);
+  }
+
+ private:
+  static constexpr size_t kMaxRootSamples = 1 << 20;
+  static constexpr size_t kLeavesPerBlock = 256;
+
+  // Calls fn(begin, end) on blocks of [0, n), handed out to `num_threads`
+  // threads one block at a time.
+  template <typename Fn>
+  static void ForEachBlock(size_t n, size_t block, size_t num_threads, Fn&& fn) {
+    std::atomic<size_t> next(0);
+    auto work = [&] {
+      for (size_t begin = next.fetch_add(block); begin < n;
+           begin = next.fetch_add(block))
+        fn(begin, std::min(n, begin + block));
+    };
+    num_threads = std::max<size_t>(1, std::min(num_threads, (n + block - 1) / block));
+    std::vector<std::thread> workers;
+    for (size_t t = 1; t < num_threads; ++t) workers.emplace_back(work);
+    work();
+    for (auto& worker : workers) worker.join();
+  }
+
+  RootModel<KeyType> TrainRoot(RootType type, const KeyType* keys,
+                               size_t num_keys) const {
+    RootModel<KeyType> root;
+    root.type = type;
+    if (num_keys == 0) return root;
+
+    const KeyType min_key = keys[0];
+    const KeyType max_key = keys[num_keys - 1];
+    root.min_key = min_key;
+
+    if (type == RootType::Radix) {
+      const uint64_t diff = static_cast<uint64_t>(max_key - min_key);
+      const unsigned bits = diff == 0 ? 0 : 64 - __builtin_clzll(diff);
+      root.shift = bits > num_leaves_log_ ? bits - num_leaves_log_ : 0;
+      root.num_leaves = (diff >> root.shift) + 1;
+      return root;
+    }
+
+    root.num_leaves = size_t(1) << num_leaves_log_;
+    if (max_key == min_key) return root;
+    root.scale = 1.0 / static_cast<double>(max_key - min_key);
+    // Targets are positions scaled to leaves.
+    const double leaf_scale = static_cast<double>(root.num_leaves) / num_keys;
+
+    if (type == RootType::LinearSpline) {
+      root.c = (num_keys - 1) * leaf_scale;
+      return root;
+    }
+
+    // Least squares over evenly spaced samples, in long double as the normal
+    // equations of the cubic are badly conditioned.
+    const size_t num_samples = std::min(num_keys, kMaxRootSamples);
+    const int degree = (type == RootType::Cubic) ? 3 : 1;
+    long double moments[7] = {0};  // Sum of t^k.
+    long double targets[4] = {0};  // Sum of y * t^k.
+    for (size_t s = 0; s < num_samples; ++s) {
+      const size_t pos =
+          num_samples == 1 ? 0 : s * (num_keys - 1) / (num_samples - 1);
+      const long double t = static_cast<double>(keys[pos] - min_key) * root.scale;
+      const long double y = pos * leaf_scale;
+      long double power = 1;
+      for (int k = 0; k <= 2 * degree; ++k) {
+        moments[k] += power;
+        if (k <= degree) targets[k] += y * power;
+        power *= t;
+      }
+    }
+
+    long double coeffs[4] = {0};
+    if (!Solve(moments, targets, degree, coeffs)) {
+      root.type = RootType::LinearSpline;
+      root.c = (num_keys - 1) * leaf_scale;
+      return root;
+    }
+    if (degree == 1) {
+      root.c = std::max<double>(0, coeffs[1]);
+      root.d = coeffs[0];
+      return root;
+    }
+
+    // The cubic must not decrease on [0, 1], or keys of one leaf would not
+    // be contiguous.
+    const double a = coeffs[3], b = coeffs[2], c = coeffs[1];
+    auto derivative = [&](double t) { return (3 * a * t + 2 * b) * t + c; };
+    bool monotone = derivative(0) >= 0 && derivative(1) >= 0;
+    if (a != 0) {
+      const double vertex = -b / (3 * a);
+      if (vertex > 0 && vertex < 1) monotone &= derivative(vertex) >= 0;
+    }
+    if (!monotone) {
+      root.type = RootType::LinearSpline;
+      root.c = (num_keys - 1) * leaf_scale;
+      return root;
+    }
+    root.a = a;
+    root.b = b;
+    root.c = c;
+    root.d = coeffs[0];
+    return root;
+  }
+
+  // Solves the normal equations of a polynomial least squares fit of the
+  // given degree by Gaussian elimination. Returns false if they are singular.
+  static bool Solve(const long double* moments, const long double* targets,
+                    int degree, long double* coeffs) {
+    const int n = degree + 1;
+    long double m[4][5];
+    for (int i = 0; i < n; ++i) {
+      for (int j = 0; j < n; ++j) m[i][j] = moments[i + j];
+      m[i][n] = targets[i];
+    }
+    for (int col = 0; col < n; ++col) {
+      int pivot = col;
+      for (int row = col + 1; row < n; ++row)
+        if (std::fabs(m[row][col]) > std::fabs(m[pivot][col])) pivot = row;
+      if (std::fabs(m[pivot][col]) < std::numeric_limits<double>::min())
+        return false;
+      std::swap(m[col], m[pivot]);
+      for (int row = col + 1; row < n; ++row) {
+        const long double factor = m[row][col] / m[col][col];
+        for (int j = col; j <= n; ++j) m[row][j] -= factor * m[col][j];
+      }
+    }
+    for (int row = n - 1; row >= 0; --row) {
+      long double sum = m[row][n];
+      for (int j = row + 1; j < n; ++j) sum -= m[row][j] * coeffs[j];
+      coeffs[row] = sum / m[row][row];
+    }
+    return true;
+  }
+
+  // Fits the leaves and their error bounds. Returns false if the root does
+  // not assign every leaf a contiguous key range.
+  static bool TrainLeaves(const RootModel<KeyType>& root, const KeyType* keys,
+                          size_t num_keys, size_t num_threads,
+                          std::vector<Leaf>& leaves) {
+    const size_t num_leaves = root.num_leaves;
+    leaves.assign(num_leaves, Leaf{0, 0, 0, 0, 0});
+    if (num_keys == 0) return true;
+
+    // First position of each leaf, assuming that the root is monotone.
+    std::vector<size_t> bounds(num_leaves + 1, num_keys);
+    bounds[0] = 0;
+    ForEachBlock(num_leaves, kLeavesPerBlock, num_threads,
+                 [&](size_t begin, size_t end) {
+      for (size_t leaf = std::max<size_t>(begin, 1); leaf < end; ++leaf) {
+        bounds[leaf] = std::partition_point(keys, keys + num_keys,
+                                            [&](const KeyType& key) {
+                         return root.Predict(key) < leaf;
+                       }) - keys;
+      }
+    });
+
+    std::atomic<bool> contiguous(true);
+    ForEachBlock(num_leaves, kLeavesPerBlock, num_threads,
+                 [&](size_t begin, size_t end) {
+      for (size_t leaf = begin; leaf < end; ++leaf) {
+        if (!TrainLeaf(root, keys, bounds[leaf], bounds[leaf + 1], leaf,
+                       leaves[leaf]))
+          contiguous = false;
+      }
+    });
+    return contiguous;
+  }
+
+  // Fits a linear model to the keys in [begin, end), each mapped to the
+  // position of its first occurrence, which is where a lookup finds it.
+  static bool TrainLeaf(const RootModel<KeyType>& root, const KeyType* keys,
+                        size_t begin, size_t end, size_t leaf_index,
+                        Leaf& leaf) {
+    assert(end - begin <= std::numeric_limits<uint32_t>::max());
+    leaf.begin = begin;
+    leaf.count = end - begin;
+    leaf.slope = 0;
+    leaf.intercept = begin;
+    leaf.error = 0;
+    if (begin == end) return true;
+
+    // Center on the first key so that sums stay small.
+    const double x0 = static_cast<double>(keys[begin]);
+    double sum_x = 0, sum_y = 0;
+    size_t first = begin;
+    for (size_t i = begin; i < end; ++i) {
+      if (keys[i] != keys[first]) first = i;
+      sum_x += static_cast<double>(keys[i]) - x0;
+      sum_y += first - begin;
+    }
+    const double mean_x = sum_x / (end - begin);
+    const double mean_y = sum_y / (end - begin);
+    double cov = 0, var = 0;
+    first = begin;
+    for (size_t i = begin; i < end; ++i) {
+      if (keys[i] != keys[first]) first = i;
+      const double dx = static_cast<double>(keys[i]) - x0 - mean_x;
+      cov += dx * ((first - begin) - mean_y);
+      var += dx * dx;
+    }
+    if (var > 0) leaf.slope = std::max(0.0, cov / var);
+    leaf.intercept = begin + mean_y - leaf.slope * (mean_x + x0);
+
+    // Error bound, measured with the same arithmetic as lookups.
+    double error = 0;
+    first = begin;
+    for (size_t i = begin; i < end; ++i) {
+      if (root.Predict(keys[i]) != leaf_index) return false;
+      if (keys[i] != keys[first]) first = i;
+      const double estimate =
+          std::fma(leaf.slope, static_cast<double>(keys[i]), leaf.intercept);
+      const double clamped =
+          std::min<double>(std::max<double>(estimate, begin), end);
+      error = std::max(error, std::fabs(clamped - first));
+    }
+    leaf.error = static_cast<uint32_t>(std::ceil(error));
+    return true;
+  }
+
+  const RootType root_type_;
+  const size_t num_leaves_log_;
+};
+
+}  // namespace rmi_native
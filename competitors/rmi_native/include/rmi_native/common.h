@@ -0,0 +1,63 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace rmi_native {
+
+// Model types of the root layer.
+enum class RootType : int { Linear = 0, Cubic = 1, Radix = 2, LinearSpline = 3 };
+
+inline std::string RootName(RootType type) {
+  switch (type) {
+    case RootType::Linear: return "linear";
+    case RootType::Cubic: return "cubic";
+    case RootType::Radix: return "radix";
+    case RootType::LinearSpline: return "linear_spline";
+  }
+  return "unknown";
+}
+
+// Root model, mapping a key to a leaf. Linear, linear spline and cubic roots
+// are all evaluated as a cubic polynomial over the key normalized to [0, 1];
+// a radix root takes the top bits of the key's offset from the smallest key.
+template <class KeyType>
+struct RootModel {
+  RootType type = RootType::Linear;
+  KeyType min_key = 0;
+  double scale = 0;  // 1 / (max_key - min_key).
+  double a = 0, b = 0, c = 0, d = 0;
+  unsigned shift = 0;
+  size_t num_leaves = 1;
+
+  size_t Predict(const KeyType key) const {
+    if (key <= min_key) return 0;
+    if (type == RootType::Radix)
+      return std::min<size_t>((key - min_key) >> shift, num_leaves - 1);
+    const double t = static_cast<double>(key - min_key) * scale;
+    const double leaf = std::fma(std::fma(std::fma(a, t, b), t, c), t, d);
+    if (leaf <= 0) return 0;
+    if (leaf >= num_leaves - 1) return num_leaves - 1;
+    return static_cast<size_t>(leaf);
+  }
+};
+
+// Linear model of the keys of one leaf, two leaves per cache line.
+struct alignas(32) Leaf {
+  double slope;
+  double intercept;
+  uint64_t begin;  // Position of the first key of the leaf.
+  uint32_t count;  // Number of keys of the leaf.
+  uint32_t error;  // Maximum distance of a prediction from its key.
+};
+
+struct SearchBound {
+  size_t begin;
+  size_t pos;
+  size_t end;  // Exclusive.
+};
+
+}  // namespace rmi_native
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "common.h"
+
+namespace rmi_native {
+
+// Two-layer recursive model index, evaluated at runtime from its parameters:
+// a root model picks a leaf, whose linear model predicts the position of the
+// key within the error bound of the leaf.
+template <class KeyType>
+class RMI {
+ public:
+  RMI() = default;
+
+  RMI(RootModel<KeyType> root, std::vector<Leaf> leaves, size_t num_keys)
+      : root_(root),
+        owned_leaves_(std::move(leaves)),
+        leaves_(owned_leaves_.data()),
+        num_leaves_(owned_leaves_.size()),
+        num_keys_(num_keys) {}
+
+  // Moving keeps the buffer of owned leaves, and so `leaves_` valid.
+  RMI(const RMI&) = delete;
+  RMI& operator=(const RMI&) = delete;
+  RMI(RMI&&) = default;
+  RMI& operator=(RMI&&) = default;
+
+  // Returns the search bound [begin, end) of `key` and the predicted position
+  // in it. The bound never leaves the key range of the leaf: a key beyond its
+  // keys lies at one of the leaf's ends.
+  SearchBound GetSearchBound(const KeyType key) const {
+    const Leaf& leaf = leaves_[root_.Predict(key)];
+    const size_t leaf_end = leaf.begin + leaf.count;
+    const double estimate =
+        std::fma(leaf.slope, static_cast<double>(key), leaf.intercept);
+    size_t pos;
+    if (estimate <= leaf.begin) {
+      pos = leaf.begin;
+    } else if (estimate >= leaf_end) {
+      pos = leaf_end;
+    } else {
+      pos = static_cast<size_t>(estimate);
+    }
+    const size_t begin =
+        (pos < leaf.begin + leaf.error + 1) ? leaf.begin : (pos - leaf.error - 1);
+    const size_t end = std::min(leaf_end, pos + leaf.error + 2);
+    return SearchBound{begin, std::min(pos, end > begin ? end - 1 : begin), end};
+  }
+
+  const RootModel<KeyType>& root() const { return root_; }
+
+  size_t num_leaves() const { return num_leaves_; }
+
+  // Returns the size in bytes.
+  size_t GetSize() const { return sizeof(*this) + num_leaves_ * sizeof(Leaf); }
+
+  // Adds the model parameters to a snapshot.
+  template <class Writer>
+  void Save(Writer& out) const {
+    out.AddValue(root_);
+    out.Add(leaves_, num_leaves_);
+    out.AddValue(num_keys_);
+  }
+
+  // Replaces the model by the one in the next sections of a snapshot. The
+  // leaves are used in place, keeping the snapshot mapped.
+  template <class Reader>
+  void Load(Reader& in) {
+    root_ = in.template NextValue<RootModel<KeyType>>();
+    const auto leaves = in.template Next<Leaf>();
+    num_keys_ = in.template NextValue<size_t>();
+    owned_leaves_.clear();
+    owned_leaves_.shrink_to_fit();
+    leaves_ = leaves.data();
+    num_leaves_ = leaves.size();
+    owner_ = in.file();
+  }
+
+ private:
+  RootModel<KeyType> root_;
+  // Leaves, either owned or in a mapped snapshot.
+  std::vector<Leaf> owned_leaves_;
+  const Leaf* leaves_ = nullptr;
+  size_t num_leaves_ = 0;
+  size_t num_keys_ = 0;
+  std::shared_ptr<const void> owner_;
+};
+
+}  // namespace rmi_native
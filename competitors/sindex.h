@@ -152,6 +152,17 @@ class SIndex : public Competitor<KeyType, SearchClass> {
     table->put(index_key_t(data.key), data.value, thread_id);
   }
 
+  void Delete(const KeyType& key, uint32_t thread_id) {
+    table->remove(index_key_t(key), thread_id);
+  }
+
+  // put() replaces the value of a present key.
+  void Update(const KeyValue<KeyType>& data, uint32_t thread_id) {
+    table->put(index_key_t(data.key), data.value, thread_id);
+  }
+
+  bool deletable() const { return true; }
+
   std::string name() const { return "SIndex"; }
 
   std::size_t size() const { return table->size(); }
@@ -161,6 +172,9 @@ class SIndex : public Competitor<KeyType, SearchClass> {
     return name != "LinearAVX" && name != "InterpolationSearch" && std::is_same<KeyType, std::string>::value && unique;
   }
 
+  // Adjusts its models in background threads.
+  bool forkable() const { return false; }
+
   std::vector<std::string> variants() const { 
     std::vector<std::string> vec;
     vec.push_back(SearchClass::name());
@@ -169,48 +183,9 @@ class SIndex : public Competitor<KeyType, SearchClass> {
     return vec;
   }
 
-  struct alignas(CACHELINE_SIZE) SIndexParam{
-    FGParam* param;
-    void *(* func)(void *);
-  };
-
-  static void * myFunc(void * param){
-    SIndexParam &thread_param = *(SIndexParam *)param;
-    auto p = (*thread_param.func)((void *)thread_param.param);
-    sindex::config.rcu_status[thread_param.param->thread_id].status =  std::numeric_limits<long long>::max();
-    return p;
-  }
-
-  uint64_t runMultithread(void *(* func)(void *), FGParam *params) {
-    pthread_t threads[num_workers_];
-    SIndexParam sindexParams[num_workers_];
-
-    for (size_t worker_i = 0; worker_i < num_workers_; worker_i++) {
-      sindexParams[worker_i].func = func;
-      sindexParams[worker_i].param = &params[worker_i];
-      int ret = pthread_create(&threads[worker_i], nullptr, myFunc, (void *)&sindexParams[worker_i]);
-      if (ret) {
-        std::cout << "Error: " << ret << std::endl;
-      }
-    }
-
-    std::cout << "[micro] prepare data ...\n";
-    while (util::ready_threads < num_workers_) sleep(1);
-    util::running = true;
-
-    uint64_t timing = util::timing([&] {
-      while (util::running)
-        ;
-    });
-
-    void *status;
-    for (size_t i = 0; i < num_workers_; i++) {
-      int rc = pthread_join(threads[i], &status);
-      if (rc) {
-        std::cout << "Error:unable to join, " << rc << std::endl;
-      }
-    }
-    return timing;
+  void exitThread(uint32_t thread_id) {
+    // Mark the thread as quiescent, so that background RCU barriers do not wait for it.
+    sindex::config.rcu_status[thread_id].status = std::numeric_limits<long long>::max();
   }
 
  private:
@@ -540,8 +540,8 @@ inline size_t Group<key_t, val_t, seq, SearchClass, max_model_n>::binary_search_
                    ? pos
                    : (search_begin + search_end) / 2;
   mid = SearchClass::lower_bound(data + search_begin, data + search_end, key, data + mid,
-                           std::function<key_t(record_t *const)>([](record_t *const it)->key_t{ return  it->first; }),
-                           std::function<bool(const key_t&, const key_t&)>([&](const key_t& key1, const key_t& key2)->bool{ return key1.less_than(key2, prefix_len, feature_len); }))
+                           [](record_t *const it)->key_t{ return  it->first; },
+                           [&](const key_t& key1, const key_t& key2)->bool{ return key1.less_than(key2, prefix_len, feature_len); })
                            - data;
   // while (search_end != search_begin) {
   //   if (data[mid].first.less_than(key, prefix_len, feature_len)) {
@@ -636,7 +636,7 @@ inline size_t Group<key_t, val_t, seq, SearchClass, max_model_n>::exponential_se
   pos = (pos >= array_size ? (array_size - 1) : pos);
   assert(pos < array_size);
   size_t end_i = SearchClass::lower_bound(data, data + array_size, key, data + pos, 
-                           std::function<key_t(record_t *const)>([](record_t *const it)->key_t{ return  it->first; }))
+                           [](record_t *const it)->key_t{ return  it->first; })
                            - data;
   assert(data[end_i].first == key || end_i == 0 || end_i == (int)array_size ||
          (data[end_i - 1].first < key && data[end_i].first > key));
@@ -652,8 +652,8 @@ inline size_t Group<key_t, val_t, seq, SearchClass, max_model_n>::exponential_se
   pos = (pos >= array_size ? (array_size - 1) : pos);
   assert(pos < array_size);
   size_t end_i = SearchClass::lower_bound(data, data + array_size, key, data + pos, 
-                           std::function<key_t(record_t *const)>([](record_t *const it)->key_t{ return  it->first; }),
-                           std::function<bool(const key_t&, const key_t&)>([&](const key_t& key1, const key_t& key2)->bool{ return key1.less_than(key2, prefix_len, feature_len); }))
+                           [](record_t *const it)->key_t{ return  it->first; },
+                           [&](const key_t& key1, const key_t& key2)->bool{ return key1.less_than(key2, prefix_len, feature_len); })
                            - data;
 
   // int begin_i = 0, end_i = array_size;
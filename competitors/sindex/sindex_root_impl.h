@@ -598,7 +598,7 @@ Root<key_t, val_t, seq, SearchClass>::locate_group_pt1(const key_t &key, int &gr
 
   // exponential search
   long long end_group_i = SearchClass::upper_bound(groups.get(), groups.get() + group_n, key, groups.get() + group_i,
-                           std::function<key_t(std::pair<key_t, group_t *volatile>*)>([&](std::pair<key_t, group_t *volatile>* it)->key_t{ return it->first; })) - groups.get() - 1;
+                           [&](std::pair<key_t, group_t *volatile>* it)->key_t{ return it->first; }) - groups.get() - 1;
   // int begin_group_i, end_group_i;
   // if (get_group_pivot(group_i) <= key) {
   //   size_t step = 1;
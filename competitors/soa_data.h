@@ -0,0 +1,128 @@
+#pragma once
+
+#include <new>
+#include <vector>
+
+#include "../util.h"
+#include "../utils/snapshot.h"
+
+// Allocates arrays aligned to cache lines.
+template <class T>
+class CacheAlignedAllocator {
+ public:
+  using value_type = T;
+
+  template <class U>
+  struct rebind {
+    typedef CacheAlignedAllocator<U> other;
+  };
+
+  CacheAlignedAllocator() noexcept {}
+  template <class U>
+  CacheAlignedAllocator(const CacheAlignedAllocator<U>&) noexcept {}
+
+  T* allocate(std::size_t n) {
+    return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(CACHELINE_SIZE)));
+  }
+
+  void deallocate(T* p, std::size_t) noexcept {
+    ::operator delete(p, std::align_val_t(CACHELINE_SIZE));
+  }
+
+  template <class U>
+  bool operator==(const CacheAlignedAllocator<U>&) const noexcept { return true; }
+  template <class U>
+  bool operator!=(const CacheAlignedAllocator<U>&) const noexcept { return false; }
+};
+
+// Sorted key-value pairs of array-backed indexes, stored as a structure of
+// arrays: the keys in one cache-line aligned array and the payloads in
+// another. Last-mile searches run on keys() and touch only key cache lines,
+// and vectorized searches such as LinearAVX load consecutive keys.
+// The arrays are either owned or viewed in place in a loaded snapshot.
+template <class KeyType>
+class SoAData {
+ public:
+  typedef const KeyType* Iterator;
+
+  SoAData() = default;
+  // keys_ and values_ point into the arrays of this instance.
+  SoAData(const SoAData&) = delete;
+  SoAData& operator=(const SoAData&) = delete;
+
+  void Assign(const std::vector<KeyValue<KeyType>>& data) {
+    owned_keys_.resize(data.size());
+    owned_values_.resize(data.size());
+    for (size_t i = 0; i < data.size(); ++i){
+      owned_keys_[i] = data[i].key;
+      owned_values_[i] = data[i].value;
+    }
+    keys_ = owned_keys_.data();
+    values_ = owned_values_.data();
+    size_ = data.size();
+    snapshot_.reset();
+  }
+
+  // Adds the keys and the payloads as two sections of `snapshot`.
+  void Save(util::SnapshotWriter& snapshot) const {
+    snapshot.Add(keys_, size_);
+    snapshot.Add(values_, size_);
+  }
+
+  // Views the keys and the payloads of the next two sections of `snapshot`.
+  void Load(util::SnapshotReader& snapshot) {
+    const util::DataSpan<KeyType> keys = snapshot.Next<KeyType>();
+    const util::DataSpan<uint64_t> values = snapshot.Next<uint64_t>();
+    if (keys.size() != values.size()){
+      util::fail("snapshot has different numbers of keys and payloads");
+    }
+    owned_keys_.clear();
+    owned_keys_.shrink_to_fit();
+    owned_values_.clear();
+    owned_values_.shrink_to_fit();
+    keys_ = keys.data();
+    values_ = values.data();
+    size_ = keys.size();
+    snapshot_ = snapshot.file();
+  }
+
+  size_t size() const { return size_; }
+
+  // Key column, to be searched.
+  Iterator keys() const { return keys_; }
+  Iterator keys_end() const { return keys_ + size_; }
+
+  const KeyType& key(size_t i) const { return keys_[i]; }
+  uint64_t value(size_t i) const { return values_[i]; }
+
+  // Position of `it` if it points to `lookup_key`, util::OVERFLOW otherwise.
+  size_t Find(Iterator it, const KeyType& lookup_key) const {
+    if (it == keys_end() || *it != lookup_key){
+      return util::OVERFLOW;
+    }
+    return it - keys();
+  }
+
+  // Sum of the values from position `pos` on, up to the last key <= `upper_key`.
+  uint64_t SumUpTo(size_t pos, const KeyType& upper_key) const {
+    uint64_t result = 0;
+    while (pos < size_ && keys_[pos] <= upper_key){
+      result += values_[pos];
+      ++pos;
+    }
+    return result;
+  }
+
+  void Prefetch(size_t pos) const {
+    __builtin_prefetch(keys_ + pos);
+  }
+
+ private:
+  const KeyType* keys_ = nullptr;
+  const uint64_t* values_ = nullptr;
+  size_t size_ = 0;
+  std::vector<KeyType, CacheAlignedAllocator<KeyType>> owned_keys_;
+  std::vector<uint64_t> owned_values_;
+  // Mapping of the snapshot the arrays were loaded from.
+  std::shared_ptr<const util::MappedFile> snapshot_;
+};
@@ -43,6 +43,8 @@
 #include <ostream>
 #include <memory>
 #include <cstddef>
+#include <thread>
+#include <vector>
 #include <assert.h>
 
 // *** Debugging Macros
@@ -1819,6 +1821,49 @@ public:
             ? const_iterator(leaf, slot) : end();
     }
 
+    /// Locates n keys at once, descending the tree level by level for all of
+    /// them and prefetching the nodes of the next level before they are
+    /// searched, so that the cache misses of different keys overlap. Calls
+    /// out(i, it) with the result find(keys[i]) would return.
+    template <typename Output>
+    void find_batch(const key_type *keys, size_t n, Output out) const
+    {
+        const node *nodes[n];
+        for (size_t i = 0; i < n; ++i)
+            nodes[i] = m_root;
+        if (!m_root)
+        {
+            for (size_t i = 0; i < n; ++i)
+                out(i, end());
+            return;
+        }
+
+        // All leaves are on the same level, so every key descends in lock step.
+        while (!nodes[0]->isleafnode())
+        {
+            for (size_t i = 0; i < n; ++i)
+            {
+                const inner_node *inner = static_cast<const inner_node*>(nodes[i]);
+                int slot = find_lower(inner, keys[i]);
+                nodes[i] = inner->childid[slot];
+
+                __builtin_prefetch(nodes[i]);
+                if (inner->level == 1)
+                    __builtin_prefetch(&static_cast<const leaf_node*>(nodes[i])->slotkey[leafslotmax / 2]);
+                else
+                    __builtin_prefetch(&static_cast<const inner_node*>(nodes[i])->slotkey[innerslotmax / 2]);
+            }
+        }
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            const leaf_node *leaf = static_cast<const leaf_node*>(nodes[i]);
+            int slot = find_lower(leaf, keys[i]);
+            out(i, (slot < leaf->slotuse && key_equal(keys[i], leaf->slotkey[slot]))
+                ? const_iterator(leaf, slot) : end());
+        }
+    }
+
     /// Tries to locate a key in the B+ tree and returns the number of
     /// identical key entries found.
     size_type count(const key_type &key) const
@@ -2399,8 +2444,10 @@ public:
 
     /// Bulk load a sorted range. Loads items into leaves and constructs a
     /// B-tree above them. The tree must be empty when calling this function.
+    /// The leaves are allocated and linked in order, then filled by
+    /// num_threads threads, each copying a contiguous run of leaves.
     template <typename Iterator>
-    void bulk_load(Iterator ibegin, Iterator iend)
+    void bulk_load(Iterator ibegin, Iterator iend, size_t num_threads = 1)
     {
         BTREE_ASSERT(empty());
 
@@ -2412,17 +2459,15 @@ public:
 
         BTREE_PRINT("btree::bulk_load, level 0: " << m_stats.itemcount << " items into " << num_leaves << " leaves with up to " << ((iend - ibegin + num_leaves-1) / num_leaves) << " items per leaf.");
 
-        Iterator it = ibegin;
+        std::vector<std::pair<leaf_node*, size_t> > leaves(num_leaves);
+        size_t offset = 0;
         for (size_t i = 0; i < num_leaves; ++i)
         {
             // allocate new leaf node
             leaf_node* leaf = allocate_leaf();
 
-            // copy keys or (key,value) pairs into leaf nodes, uses template
-            // switch leaf->set_slot().
             leaf->slotuse = static_cast<int>(num_items / (num_leaves-i));
-            for (size_t s = 0; s < leaf->slotuse; ++s, ++it)
-                leaf->set_slot(s, *it);
+            leaves[i] = std::make_pair(leaf, offset);
 
             if (m_tailleaf != NULL) {
                 m_tailleaf->nextleaf = leaf;
@@ -2433,10 +2478,30 @@ public:
             }
             m_tailleaf = leaf;
 
+            offset += leaf->slotuse;
             num_items -= leaf->slotuse;
         }
 
-        BTREE_ASSERT( it == iend && num_items == 0 );
+        BTREE_ASSERT( ibegin + offset == iend && num_items == 0 );
+
+        // copy keys or (key,value) pairs into leaf nodes, uses template
+        // switch leaf->set_slot().
+        num_threads = std::max<size_t>(1, std::min(num_threads, num_leaves));
+        auto fill = [&](size_t t) {
+            for (size_t i = num_leaves * t / num_threads; i < num_leaves * (t+1) / num_threads; ++i)
+            {
+                leaf_node* leaf = leaves[i].first;
+                Iterator it = ibegin + leaves[i].second;
+                for (size_t s = 0; s < leaf->slotuse; ++s, ++it)
+                    leaf->set_slot(s, *it);
+            }
+        };
+        std::vector<std::thread> workers;
+        for (size_t t = 1; t < num_threads; ++t)
+            workers.emplace_back(fill, t);
+        fill(0);
+        for (size_t t = 0; t < workers.size(); ++t)
+            workers[t].join();
 
         // if the btree is so small to fit into one leaf, then we're done.
         if (m_headleaf == m_tailleaf) {
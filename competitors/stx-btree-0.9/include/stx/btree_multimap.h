@@ -354,6 +354,14 @@ public:
         return tree.find(key);
     }
 
+    /// Locates n keys at once and calls out(i, it) with the result of
+    /// find(keys[i]). See btree::find_batch.
+    template <typename Output>
+    void find_batch(const key_type *keys, size_t n, Output out) const
+    {
+        tree.find_batch(keys, n, out);
+    }
+
     /// Tries to locate a key in the B+ tree and returns the number of
     /// identical key entries found.
     size_type count(const key_type &key) const
@@ -516,11 +524,11 @@ public:
 
     /// Bulk load a sorted range [first,last). Loads items into leaves and
     /// constructs a B-tree above them. The tree must be empty when calling
-    /// this function.
+    /// this function. The leaves are filled by num_threads threads.
     template <typename Iterator>
-    inline void bulk_load(Iterator first, Iterator last)
+    inline void bulk_load(Iterator first, Iterator last, size_t num_threads = 1)
     {
-        return tree.bulk_load(first, last);
+        return tree.bulk_load(first, last, num_threads);
     }
 
 public:
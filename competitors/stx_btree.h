@@ -2,6 +2,7 @@
 
 #include <stx/btree_multimap.h>
 
+#include "../utils/projection.h"
 #include "../utils/tracking_allocator.h"
 #include "base.h"
 
@@ -12,15 +13,9 @@ class STXBTree : public Competitor<KeyType, SearchClass> {
       : btree_(TrackingAllocator<std::pair<KeyType, uint64_t>>(
             total_allocation_size)) {}
   uint64_t Build(const std::vector<KeyValue<KeyType>>& data, const size_t num_threads) {
-    std::vector<std::pair<KeyType, uint64_t>> reformatted_data;
-    reformatted_data.reserve(data.size());
-
-    for (const auto& iter : data) {
-      reformatted_data.emplace_back(iter.key, iter.value);
-    }
-
+    const auto pairs = util::pairs_of(data);
     return util::timing([&] {
-      btree_.bulk_load(reformatted_data.begin(), reformatted_data.end());
+      btree_.bulk_load(pairs.begin(), pairs.end(), num_threads);
     });
   }
 
@@ -37,6 +32,13 @@ class STXBTree : public Competitor<KeyType, SearchClass> {
     return guess;
   }
 
+  bool EqualityLookupBatch(const KeyType* lookup_keys, size_t n, size_t* out, uint32_t thread_id) const {
+    btree_.find_batch(lookup_keys, n, [&](size_t i, typename decltype(btree_)::const_iterator it) {
+      out[i] = (it == btree_.end()) ? util::NOT_FOUND : it->second;
+    });
+    return true;
+  }
+
   uint64_t RangeQuery(const KeyType lower_key, const KeyType upper_key, uint32_t thread_id) const {
     auto it = btree_.lower_bound(lower_key);
     uint64_t result = 0;
@@ -51,6 +53,20 @@ class STXBTree : public Competitor<KeyType, SearchClass> {
     btree_.insert(data.key, data.value);
   }
 
+  void Delete(const KeyType& key, uint32_t thread_id) {
+    btree_.erase_one(key);
+  }
+
+  void Update(const KeyValue<KeyType>& data, uint32_t thread_id) {
+    auto it = btree_.find(data.key);
+    if (it != btree_.end()) {
+      // operator-> points to a copy of the pair.
+      it.data() = data.value;
+    }
+  }
+
+  bool deletable() const { return true; }
+
   std::vector<std::string> variants() const { 
     std::vector<std::string> vec;
     vec.push_back(SearchClass::name());
@@ -58,6 +74,8 @@ class STXBTree : public Competitor<KeyType, SearchClass> {
     return vec;
   }
 
+  bool concurrentReads() { return true; }
+
   bool applicable(bool unique, bool range_query, bool insert, bool multithread, const std::string& ops_filename) {
         return !multithread;
     }
@@ -2,6 +2,7 @@
 
 #include "../util.h"
 #include "base.h"
+#include "soa_data.h"
 #include "ts/builder.h"
 #include "ts/ts.h"
 
@@ -18,43 +19,66 @@ class TS : public Competitor<KeyType, SearchClass> {
     }
 
     return util::timing([&] {
-      data_ = data;
+      data_.Assign(data);
       
       ts::Builder<KeyType, SearchClass> tsb(min, max, spline_max_error);
-      for (const auto& key_and_value : data) tsb.AddKey(key_and_value.key);
+      tsb.AddKeys(data_.keys(), data_.size(), num_threads);
       ts_ = tsb.Finalize();
     });
   }
 
   size_t EqualityLookup(const KeyType lookup_key, uint32_t thread_id) const {
     const ts::SearchBound sb = ts_.GetSearchBound(lookup_key);
-    typedef typename std::vector<KeyValue<KeyType>>::const_iterator Iterator;
-    auto it = SearchClass::lower_bound(data_.begin() + sb.begin, data_.begin() + sb.end, lookup_key,  
-                      data_.begin() + sb.begin, std::function<KeyType(Iterator)>([](Iterator it)->KeyType {
-                                                      return it->key; }));
-    if (it == data_.end() || it->key != lookup_key){
-      return util::OVERFLOW;
+    auto it = SearchClass::lower_bound(data_.keys() + sb.begin, data_.keys() + sb.end, lookup_key,  
+                      data_.keys() + sb.begin);
+    return data_.Find(it, lookup_key);
+  }
+
+  bool EqualityLookupBatch(const KeyType* lookup_keys, size_t n, size_t* out, uint32_t thread_id) const {
+    // Evaluate all splines first and prefetch the search windows,
+    // so that the last-mile searches of the batch overlap their misses.
+    ts::SearchBound sbs[n];
+    for (size_t i = 0; i < n; ++i){
+      sbs[i] = ts_.GetSearchBound(lookup_keys[i]);
+      data_.Prefetch(sbs[i].begin + (sbs[i].end - sbs[i].begin) / 2);
     }
-    return it - data_.begin();
+
+    for (size_t i = 0; i < n; ++i){
+      auto it = SearchClass::lower_bound(data_.keys() + sbs[i].begin, data_.keys() + sbs[i].end, lookup_keys[i],  
+                        data_.keys() + sbs[i].begin);
+      out[i] = data_.Find(it, lookup_keys[i]);
+    }
+    return true;
   }
 
   uint64_t RangeQuery(const KeyType lower_key, const KeyType upper_key, uint32_t thread_id) const {
     const ts::SearchBound sb = ts_.GetSearchBound(lower_key);
-    typedef typename std::vector<KeyValue<KeyType>>::const_iterator Iterator;
-    auto it = SearchClass::lower_bound(data_.begin() + sb.begin, data_.begin() + sb.end, lower_key,  
-                      data_.begin() + sb.begin, std::function<KeyType(Iterator)>([](Iterator it)->KeyType {
-                                                      return it->key; }));
-    uint64_t result = 0;
-    while(it != data_.end() && it->key <= upper_key){
-      result += it->value;
-      ++it;
+    auto it = SearchClass::lower_bound(data_.keys() + sb.begin, data_.keys() + sb.end, lower_key,  
+                      data_.keys() + sb.begin);
+    return data_.SumUpTo(it - data_.keys(), upper_key);
+  }
+
+  bool Save(const std::string& filename) const {
+    util::SnapshotWriter snapshot(sizeof(KeyType));
+    data_.Save(snapshot);
+    ts_.Save(snapshot);
+    return snapshot.Write(filename);
+  }
+
+  bool Load(const std::string& filename) {
+    util::SnapshotReader snapshot;
+    if (!snapshot.Open(filename, sizeof(KeyType))){
+      return false;
     }
-    return result;
+    data_.Load(snapshot);
+    ts_.Load(snapshot);
+    return true;
   }
 
+  bool concurrentReads() { return true; }
+
   bool applicable(bool unique, bool range_query, bool insert, bool multithread, const std::string& ops_filename) const {
-    std::string name = SearchClass::name();
-    return !insert && name != "LinearAVX" && !multithread;
+    return !insert && !multithread;
   }
 
   std::vector<std::string> variants() const { 
@@ -71,6 +95,6 @@ class TS : public Competitor<KeyType, SearchClass> {
  private:
 
   ts::TrieSpline<KeyType, SearchClass> ts_;
-  std::vector<KeyValue<KeyType>> data_;
+  SoAData<KeyType> data_;
   size_t spline_max_error;
 };
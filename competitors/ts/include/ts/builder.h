@@ -1,11 +1,14 @@
 #pragma once
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <limits>
 #include <map>
 #include <optional>
 #include <fstream>
+#include <thread>
+#include <vector>
 
 #include "ts_cht/builder.h"
 #include "ts_cht/cht.h"
@@ -37,6 +40,59 @@ class Builder {
     AddKey(key, prev_position_ + 1);
   }
 
+  // Adds `num_keys` sorted keys, stored in a dense array, to an empty builder.
+  // The keys are cut into `num_threads` partitions at distinct keys, and the
+  // spline of each partition is fit in parallel. The partial splines are
+  // stitched by ending each partition on its last CDF point: the segment to
+  // the first point of the next partition connects two consecutive CDF
+  // points, so the error bound still holds.
+  void AddKeys(const KeyType* keys, size_t num_keys, size_t num_threads) {
+    assert(curr_num_keys_ == 0);
+    num_threads = std::max<size_t>(1, std::min(num_threads, num_keys / (1u << 16)));
+    if (num_threads == 1) {
+      for (size_t i = 0; i < num_keys; ++i) AddKey(keys[i], i);
+      return;
+    }
+
+    std::vector<size_t> bounds{0};
+    for (size_t t = 1; t < num_threads; ++t) {
+      size_t pos = std::max(bounds.back(), num_keys * t / num_threads);
+      while (pos < num_keys && pos > 0 && keys[pos] == keys[pos - 1]) ++pos;
+      if (pos > bounds.back() && pos < num_keys) bounds.push_back(pos);
+    }
+    bounds.push_back(num_keys);
+
+    std::vector<Builder> parts;
+    parts.reserve(bounds.size() - 1);
+    for (size_t t = 0; t + 1 < bounds.size(); ++t)
+      parts.emplace_back(min_key_, max_key_, spline_max_error_);
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < parts.size(); ++t) {
+      workers.emplace_back([&, t] {
+        for (size_t i = bounds[t]; i < bounds[t + 1]; ++i)
+          parts[t].AddKey(keys[i], i);
+      });
+    }
+    for (auto& worker : workers) worker.join();
+
+    for (size_t t = 0; t < parts.size(); ++t) {
+      for (const auto& point : parts[t].spline_points_)
+        AddKeyToSpline(point.x, point.y);
+      if (t + 1 < parts.size() && spline_points_.back().x != parts[t].prev_point_.x)
+        AddKeyToSpline(parts[t].prev_point_.x, parts[t].prev_point_.y);
+    }
+
+    // Continue the corridor of the last partition.
+    const Builder& last = parts.back();
+    curr_num_keys_ = num_keys;
+    curr_num_distinct_keys_ = last.curr_num_distinct_keys_;
+    prev_key_ = last.prev_key_;
+    prev_position_ = last.prev_position_;
+    upper_limit_ = last.upper_limit_;
+    lower_limit_ = last.lower_limit_;
+    prev_point_ = last.prev_point_;
+  }
+
   // Finalizes the construction and returns a read-only `TrieSpline`.
   TrieSpline<KeyType, SearchClass> Finalize() {
     // Last key needs to be equal to `max_key_`.
@@ -66,6 +66,31 @@ class TrieSpline {
            spline_points_.size() * sizeof(Coord<KeyType>);
   }
 
+  // Adds the spline and its radix tree to a snapshot.
+  template <class Writer>
+  void Save(Writer& out) const {
+    out.AddValue(min_key_);
+    out.AddValue(max_key_);
+    const size_t params[] = {num_keys_, spline_max_error_};
+    out.Add(params, 2);
+    out.Add(spline_points_.data(), spline_points_.size());
+    cht_.Save(out);
+  }
+
+  // Replaces the spline by the one in the next sections of a snapshot.
+  template <class Reader>
+  void Load(Reader& in) {
+    min_key_ = in.template NextValue<KeyType>();
+    max_key_ = in.template NextValue<KeyType>();
+    const auto params = in.template Next<size_t>();
+    assert(params.size() == 2);
+    num_keys_ = params[0];
+    spline_max_error_ = params[1];
+    const auto spline_points = in.template Next<Coord<KeyType>>();
+    spline_points_.assign(spline_points.begin(), spline_points.end());
+    cht_.Load(in);
+  }
+
  private:
   // Returns the index of the spline point that marks the end of the spline
   // segment that contains the `key`: `key` ?(spline[index - 1], spline[index]]
@@ -87,7 +112,7 @@ class TrieSpline {
         SearchClass::lower_bound(spline_points_.begin() + range.begin,
                          spline_points_.begin() + range.end, key,
                          spline_points_.begin() + range.begin,
-                         std::function<KeyType(Iterator)>([](Iterator it)->KeyType{ return  it->x; }));
+                         [](Iterator it)->KeyType{ return  it->x; });
     return std::distance(spline_points_.begin(), lb);
   }
 
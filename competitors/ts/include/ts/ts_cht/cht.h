@@ -51,6 +51,34 @@ class CompactHistTree {
     return sizeof(*this) + table_.size() * sizeof(unsigned);
   }
 
+  // Adds the tree to a snapshot, one section per member.
+  template <class Writer>
+  void Save(Writer& out) const {
+    out.AddValue(single_layer_);
+    out.AddValue(min_key_);
+    out.AddValue(max_key_);
+    const size_t params[] = {num_keys_, num_bins_, log_num_bins_, max_error_, shift_};
+    out.Add(params, 5);
+    out.Add(table_.data(), table_.size());
+  }
+
+  // Replaces the tree by the one in the next sections of a snapshot.
+  template <class Reader>
+  void Load(Reader& in) {
+    single_layer_ = in.template NextValue<bool>();
+    min_key_ = in.template NextValue<KeyType>();
+    max_key_ = in.template NextValue<KeyType>();
+    const auto params = in.template Next<size_t>();
+    assert(params.size() == 5);
+    num_keys_ = params[0];
+    num_bins_ = params[1];
+    log_num_bins_ = params[2];
+    max_error_ = params[3];
+    shift_ = params[4];
+    const auto table = in.template Next<unsigned>();
+    table_.assign(table.begin(), table.end());
+  }
+
  private:
   static constexpr unsigned Leaf = (1u << 31);
   static constexpr unsigned Mask = Leaf - 1;
@@ -32,7 +32,9 @@ class Wormhole : public Base<KeyType> {
       for (size_t i = 0; i < num_threads_; i++) {
         free(in[i]);
         free(out[i]);
-        wormhole_unref(refs[i].instance);
+        if (refs[i].instance) {
+          wormhole_unref(refs[i].instance);
+        }
       }
       delete[] refs;
       delete[] in;
@@ -41,13 +43,12 @@ class Wormhole : public Base<KeyType> {
     }
   }
   uint64_t Build(const std::vector<KeyValue<KeyType>>& data, const size_t num_threads) {
-    std::vector<std::string> keys;
-    keys.reserve(data.size());
-    for (const KeyValue<KeyType>& kv : data) {
-      std::string key;
-      util::convert2String(kv.key, key);
-      keys.push_back(key);
-    }
+    std::vector<std::string> keys(data.size());
+    util::parallel_for(data.size(), num_threads, [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i) {
+        util::convert2String(data[i].key, keys[i]);
+      }
+    });
 
     kvmap_mm allocator = (kvmap_mm){kv_dup_in_count, kv_dup_out_count,
                                     kv_free_count, (void*)&usage_};
@@ -56,24 +57,26 @@ class Wormhole : public Base<KeyType> {
     in = new struct kv*[num_threads];
     out = new struct kv*[num_threads];
     for (size_t i = 0; i < num_threads; ++ i){
+      refs[i].instance = NULL;
       in[i] = static_cast<struct kv*>(malloc(sizeof(struct kv) + 1024 + sizeof(uint64_t)));
       out[i] = static_cast<struct kv*>(malloc(sizeof(struct kv) + 1024 + sizeof(uint64_t)));
     }
 
     uint64_t timing = util::timing([&] {
       index = wormhole_create(&allocator);
-      struct wormref * ref = wormhole_ref(index);
-      for (size_t i = 0; i < data.size(); i++) {
-        kv_refill(in[0], keys[i].c_str(), keys[i].length(), reinterpret_cast<const char* const>(&data[i].value), sizeof(uint64_t));
-        wormhole_put(ref, in[0]);
-      }
-      wormhole_unref(ref);
+      // Each thread puts a contiguous range through its own reference.
+      util::parallel_for(data.size(), num_threads, [&](size_t begin, size_t end) {
+        struct kv* buf = static_cast<struct kv*>(malloc(sizeof(struct kv) + 1024 + sizeof(uint64_t)));
+        struct wormref * ref = whsafe_ref(index);
+        for (size_t i = begin; i < end; i++) {
+          kv_refill(buf, keys[i].c_str(), keys[i].length(), reinterpret_cast<const char* const>(&data[i].value), sizeof(uint64_t));
+          whsafe_put(ref, buf);
+        }
+        wormhole_unref(ref);
+        free(buf);
+      });
     });
 
-    for (size_t i = 0; i < num_threads; ++ i){
-      refs[i].instance = whsafe_ref(index);
-    }
-
     return timing;
   }
 
@@ -117,6 +120,22 @@ class Wormhole : public Base<KeyType> {
     whsafe_put(refs[thread_id].instance, in[thread_id]);
   }
 
+  // Freed pairs leave the usage through kv_free_count.
+  void Delete(const KeyType& key, uint32_t thread_id) {
+    std::string str;
+    util::convert2String(key, str);
+    kv_refill(in[thread_id], str.c_str(), str.length(), NULL, 0);
+    kref kref = kv_kref(in[thread_id]);
+    whsafe_del(refs[thread_id].instance, &kref);
+  }
+
+  // Puts replace the pair of a present key.
+  void Update(const KeyValue<KeyType>& data, uint32_t thread_id) {
+    Insert(data, thread_id);
+  }
+
+  bool deletable() const { return true; }
+
   std::string name() const { return "Wormhole"; }
 
   std::size_t size() const {
@@ -127,46 +146,14 @@ class Wormhole : public Base<KeyType> {
     return usage_;
   }
 
-  static void * background(void * param) {
-    WormholeParam &thread_param = *(WormholeParam *)param;
-    thread_fork_join(thread_param.num_threads, thread_param.func, true, (void **)thread_param.params);
-    return nullptr;
+  // Each worker thread registers its own reference.
+  void initThread(uint32_t thread_id) {
+    refs[thread_id].instance = whsafe_ref(index);
   }
 
-  uint64_t runMultithread(void *(* func)(void *), FGParam *params) {
-    FGParam** params_ = new FGParam*[num_threads_];
-    for (size_t worker_i = 0; worker_i < num_threads_; worker_i++) {
-      params_[worker_i] = &params[worker_i];
-    }
-    pthread_t thread;
-    WormholeParam param;
-    param.func = func;
-    param.params = params_;
-    param.num_threads = num_threads_;
-
-    int ret = pthread_create(&thread, nullptr, background,
-                              (void *)&param);
-    if (ret) {
-      std::cout << "Error: " << ret << std::endl;
-    }
-
-    std::cout << "[micro] prepare data ...\n";
-    while (util::ready_threads < num_threads_) sleep(1);
-    util::running = true;
-
-    uint64_t timing = util::timing([&] {
-      while (util::running)
-        ;
-    });
-
-    void *status;
-    int rc = pthread_join(thread, &status);
-    if (rc) {
-      std::cout << "Error:unable to join, " << rc << std::endl;
-    }
-
-    delete[] params_;
-    return timing;
+  void exitThread(uint32_t thread_id) {
+    wormhole_unref(refs[thread_id].instance);
+    refs[thread_id].instance = NULL;
   }
 
   bool applicable(bool unique, bool range_query, bool insert, bool multithread, const std::string& ops_filename) {
@@ -178,12 +165,6 @@ class Wormhole : public Base<KeyType> {
   struct alignas(CACHELINE_SIZE) wormref_align {
     struct wormref *instance;
   };
-  struct alignas(CACHELINE_SIZE) WormholeParam{
-    void *(* func)(void *); 
-    FGParam** params;
-    size_t num_threads;
-  };
-
   struct wormhole* index = NULL;
   struct wormref_align* refs = NULL;
   int64_t usage_ = 0;
@@ -7,6 +7,7 @@
 #include <vector>
 
 #include "../util.h"
+#include "../utils/projection.h"
 #include "base.h"
 #include "xindex/xindex.h"
 #include "xindex/xindex_impl.h"
@@ -66,24 +67,18 @@ class XIndex : public Competitor<KeyType, SearchClass> {
   }
 
   uint64_t Build(const std::vector<KeyValue<KeyType>>& data, size_t num_threads) {
-    std::vector<index_key_t> keys;
-    keys.reserve(data.size());
-
-    std::vector<uint64_t> values;
-    for (const KeyValue<KeyType>& kv : data) {
-      keys.emplace_back(kv.key);
-      values.push_back(kv.value);
-    }
+    const util::Projected<KeyType, util::KeyAs<index_key_t>> keys(data);
+    const auto values = util::values_of(data);
 
     num_workers_ = num_threads;
 
     uint64_t build_time =
         util::timing([&] { 
           if (num_threads > 1){
-            table = new xindex_t(keys, values, num_workers_, (num_workers_ + 11) / 12, error_bound);
+            table = new xindex_t(keys.begin(), values.begin(), data.size(), num_workers_, (num_workers_ + 11) / 12, error_bound);
           }
           else{
-            table = new xindex_t(keys, values, 1, 1, error_bound);
+            table = new xindex_t(keys.begin(), values.begin(), data.size(), 1, 1, error_bound);
           }
     });
 
@@ -112,6 +107,17 @@ class XIndex : public Competitor<KeyType, SearchClass> {
     table->put(index_key_t(data.key), data.value, thread_id);
   }
 
+  void Delete(const KeyType& key, uint32_t thread_id) {
+    table->remove(index_key_t(key), thread_id);
+  }
+
+  // put() replaces the value of a present key.
+  void Update(const KeyValue<KeyType>& data, uint32_t thread_id) {
+    table->put(index_key_t(data.key), data.value, thread_id);
+  }
+
+  bool deletable() const { return true; }
+
   std::string name() const { return "XIndex"; }
 
   std::size_t size() const { return table->size(); }
@@ -121,6 +127,9 @@ class XIndex : public Competitor<KeyType, SearchClass> {
     return name != "LinearAVX" && name != "InterpolationSearch" && !std::is_same<KeyType, std::string>::value && unique;
   }
 
+  // Adjusts its models in background threads.
+  bool forkable() const { return false; }
+
   std::vector<std::string> variants() const { 
     std::vector<std::string> vec;
     vec.push_back(SearchClass::name());
@@ -128,48 +137,9 @@ class XIndex : public Competitor<KeyType, SearchClass> {
     return vec;
   }
 
-  struct alignas(CACHELINE_SIZE) XIndexParam{
-    FGParam* param;
-    void *(* func)(void *);
-  };
-
-  static void * myFunc(void * param){
-    XIndexParam &thread_param = *(XIndexParam *)param;
-    auto p = (*thread_param.func)((void *)thread_param.param);
-    xindex::config.rcu_status[thread_param.param->thread_id].status =  std::numeric_limits<long long>::max();
-    return p;
-  }
-
-  uint64_t runMultithread(void *(* func)(void *), FGParam *params) {
-    pthread_t threads[num_workers_];
-    XIndexParam xindexParams[num_workers_];
-
-    for (size_t worker_i = 0; worker_i < num_workers_; worker_i++) {
-      xindexParams[worker_i].func = func;
-      xindexParams[worker_i].param = &params[worker_i];
-      int ret = pthread_create(&threads[worker_i], nullptr, myFunc, (void *)&xindexParams[worker_i]);
-      if (ret) {
-        std::cout << "Error: " << ret << std::endl;
-      }
-    }
-
-    std::cout << "[micro] prepare data ...\n";
-    while (util::ready_threads < num_workers_) sleep(1);
-    util::running = true;
-
-    uint64_t timing = util::timing([&] {
-      while (util::running)
-        ;
-    });
-
-    void *status;
-    for (size_t i = 0; i < num_workers_; i++) {
-      int rc = pthread_join(threads[i], &status);
-      if (rc) {
-        std::cout << "Error:unable to join, " << rc << std::endl;
-      }
-    }
-    return timing;
+  void exitThread(uint32_t thread_id) {
+    // Mark the thread as quiescent, so that background RCU barriers do not wait for it.
+    xindex::config.rcu_status[thread_id].status = std::numeric_limits<long long>::max();
   }
 
  private:
@@ -41,6 +41,11 @@ class XIndex {
  public:
   XIndex(const std::vector<key_t> &keys, const std::vector<val_t> &vals,
          size_t worker_num, size_t bg_n, size_t error_bound);
+  // Reads the record_n sorted keys and values through random access
+  // iterators; groups copy their own ranges.
+  template <class KeyIt, class ValIt>
+  XIndex(KeyIt keys, ValIt vals, size_t record_n, size_t worker_num,
+         size_t bg_n, size_t error_bound);
   ~XIndex();
 
   inline bool get(const key_t &key, val_t &val, const uint32_t worker_id);
@@ -80,12 +80,11 @@ class alignas(CACHELINE_SIZE) Group {
  public:
   Group();
   ~Group();
-  void init(const typename std::vector<key_t>::const_iterator &keys_begin,
-            const typename std::vector<val_t>::const_iterator &vals_begin,
+  template <class KeyIt, class ValIt>
+  void init(KeyIt keys_begin, ValIt vals_begin, uint32_t array_size);
+  template <class KeyIt, class ValIt>
+  void init(KeyIt keys_begin, ValIt vals_begin, uint32_t model_n,
             uint32_t array_size);
-  void init(const typename std::vector<key_t>::const_iterator &keys_begin,
-            const typename std::vector<val_t>::const_iterator &vals_begin,
-            uint32_t model_n, uint32_t array_size);
   const key_t &get_pivot();
 
   inline result_t get(const key_t &key, val_t &val);
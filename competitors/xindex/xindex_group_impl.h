@@ -34,18 +34,16 @@ template <class key_t, class val_t, bool seq, class SearchClass, size_t max_mode
 Group<key_t, val_t, seq, SearchClass, max_model_n>::~Group() {}
 
 template <class key_t, class val_t, bool seq, class SearchClass, size_t max_model_n>
+template <class KeyIt, class ValIt>
 void Group<key_t, val_t, seq, SearchClass, max_model_n>::init(
-    const typename std::vector<key_t>::const_iterator &keys_begin,
-    const typename std::vector<val_t>::const_iterator &vals_begin,
-    uint32_t array_size) {
+    KeyIt keys_begin, ValIt vals_begin, uint32_t array_size) {
   init(keys_begin, vals_begin, 1, array_size);
 }
 
 template <class key_t, class val_t, bool seq, class SearchClass, size_t max_model_n>
+template <class KeyIt, class ValIt>
 void Group<key_t, val_t, seq, SearchClass, max_model_n>::init(
-    const typename std::vector<key_t>::const_iterator &keys_begin,
-    const typename std::vector<val_t>::const_iterator &vals_begin,
-    uint32_t model_n, uint32_t array_size) {
+    KeyIt keys_begin, ValIt vals_begin, uint32_t model_n, uint32_t array_size) {
   assert(array_size > 0);
   this->pivot = *keys_begin;
   this->array_size = array_size;
@@ -549,7 +547,7 @@ inline size_t Group<key_t, val_t, seq, SearchClass, max_model_n>::binary_search_
                    ? pos
                    : (search_begin + search_end) / 2;
   mid = SearchClass::lower_bound(data + search_begin, data + search_end, key, data + mid,
-                           std::function<key_t(record_t *const)>([](record_t *const it)->key_t{ return  it->first; }))
+                           [](record_t *const it)->key_t{ return  it->first; })
                            - data;
   
   // while (search_end != search_begin) {
@@ -643,7 +641,7 @@ inline size_t Group<key_t, val_t, seq, SearchClass, max_model_n>::exponential_se
   pos = (pos >= array_size ? (array_size - 1) : pos);
   assert(pos < array_size);
   size_t end_i = SearchClass::lower_bound(data, data + array_size, key, data + pos, 
-                           std::function<key_t(record_t *const)>([](record_t *const it)->key_t{ return  it->first; }))
+                           [](record_t *const it)->key_t{ return  it->first; })
                            - data;
 
   // int begin_i = 0, end_i = array_size;
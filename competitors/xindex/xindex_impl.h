@@ -36,6 +36,14 @@ XIndex<key_t, val_t, seq, SearchClass>::XIndex(const std::vector<key_t> &keys,
                                   const std::vector<val_t> &vals,
                                   size_t worker_num, size_t bg_n,
                                   size_t error_bound)
+    : XIndex(keys.begin(), vals.begin(), keys.size(), worker_num, bg_n,
+             error_bound) {}
+
+template <class key_t, class val_t, bool seq, class SearchClass>
+template <class KeyIt, class ValIt>
+XIndex<key_t, val_t, seq, SearchClass>::XIndex(KeyIt keys, ValIt vals,
+                                  size_t record_n, size_t worker_num,
+                                  size_t bg_n, size_t error_bound)
     : bg_num(bg_n) {
   config.worker_n = worker_num;
   config.root_error_bound = config.group_error_bound = error_bound;
@@ -49,14 +57,14 @@ XIndex<key_t, val_t, seq, SearchClass>::XIndex(const std::vector<key_t> &keys,
   INVARIANT(config.buffer_compact_threshold > 0);
   INVARIANT(config.worker_n > 0);
 
-  for (size_t key_i = 1; key_i < keys.size(); key_i++) {
+  for (size_t key_i = 1; key_i < record_n; key_i++) {
     assert(keys[key_i] >= keys[key_i - 1]);
   }
   rcu_init();
 
   // malloc memory for root & init root
   root = new root_t();
-  root->init(keys, vals);
+  root->init(keys, vals, record_n);
   start_bg();
 }
 
@@ -44,9 +44,8 @@ void LinearModel<key_t>::prepare(const std::vector<key_t> &keys,
 }
 
 template <class key_t>
-void LinearModel<key_t>::prepare(
-    const typename std::vector<key_t>::const_iterator &keys_begin,
-    uint32_t size) {
+template <class KeyIt>
+void LinearModel<key_t>::prepare(KeyIt keys_begin, uint32_t size) {
   if (size == 0) return;
 
   std::vector<model_key_t> model_keys(size);
@@ -231,9 +230,8 @@ size_t LinearModel<key_t>::get_error_bound(
 }
 
 template <class key_t>
-size_t LinearModel<key_t>::get_error_bound(
-    const typename std::vector<key_t>::const_iterator &keys_begin,
-    uint32_t size) {
+template <class KeyIt>
+size_t LinearModel<key_t>::get_error_bound(KeyIt keys_begin, uint32_t size) {
   int max = 0;
 
   for (size_t key_i = 0; key_i < size; ++key_i) {
@@ -37,9 +37,10 @@ class Root {
 
  public:
   ~Root();
-  void init(const std::vector<key_t> &keys, const std::vector<val_t> &vals);
-  void calculate_err(const std::vector<key_t> &keys,
-                     const std::vector<val_t> &vals, size_t group_n_trial,
+  template <class KeyIt, class ValIt>
+  void init(KeyIt keys, ValIt vals, size_t record_n);
+  template <class KeyIt>
+  void calculate_err(KeyIt keys, size_t record_n, size_t group_n_trial,
                      double &err_at_percentile, double &max_err,
                      double &avg_err);
 
@@ -52,12 +52,12 @@ void Root<key_t, val_t, seq, SearchClass>::free_memory(){
 }
 
 template <class key_t, class val_t, bool seq, class SearchClass>
-void Root<key_t, val_t, seq, SearchClass>::init(const std::vector<key_t> &keys,
-                                   const std::vector<val_t> &vals) {
+template <class KeyIt, class ValIt>
+void Root<key_t, val_t, seq, SearchClass>::init(KeyIt keys, ValIt vals,
+                                   size_t record_n) {
   INVARIANT(seq == false);
 
   // try different initial # of groups
-  size_t record_n = keys.size();
   const size_t group_size_to_group_error_experience_ratio = 1000;
   size_t group_n_trial =
       record_n /
@@ -72,7 +72,7 @@ void Root<key_t, val_t, seq, SearchClass>::init(const std::vector<key_t> &keys,
   for (; trial_i < max_trial_n; trial_i++) {
     group_n_trial = group_n_trial != 0 ? group_n_trial : 1;
 
-    calculate_err(keys, vals, group_n_trial, actual_error_at_percentile,
+    calculate_err(keys, record_n, group_n_trial, actual_error_at_percentile,
                   max_group_error, avg_group_error);
 
     // stop when we find ping-pong
@@ -115,9 +115,9 @@ void Root<key_t, val_t, seq, SearchClass>::init(const std::vector<key_t> &keys,
     }
   }
 
-  // max group_n is keys.size()
-  if (group_n_trial > keys.size()) group_n_trial = keys.size();
-  calculate_err(keys, vals, group_n_trial, actual_error_at_percentile,
+  // max group_n is record_n
+  if (group_n_trial > record_n) group_n_trial = record_n;
+  calculate_err(keys, record_n, group_n_trial, actual_error_at_percentile,
                 max_group_error, avg_group_error);
 
   DEBUG_THIS("--- [root] final group size: "
@@ -146,7 +146,7 @@ void Root<key_t, val_t, seq, SearchClass>::init(const std::vector<key_t> &keys,
 
     groups[group_i].first = keys[begin_i];
     groups[group_i].second = new group_t();
-    groups[group_i].second->init(keys.begin() + begin_i, vals.begin() + begin_i,
+    groups[group_i].second->init(keys + begin_i, vals + begin_i,
                                  end_i - begin_i);
   }
 
@@ -164,13 +164,13 @@ void Root<key_t, val_t, seq, SearchClass>::init(const std::vector<key_t> &keys,
  * Root::calculate_err
  */
 template <class key_t, class val_t, bool seq, class SearchClass>
-void Root<key_t, val_t, seq, SearchClass>::calculate_err(const std::vector<key_t> &keys,
-                                            const std::vector<val_t> &vals,
+template <class KeyIt>
+void Root<key_t, val_t, seq, SearchClass>::calculate_err(KeyIt keys,
+                                            size_t record_n,
                                             size_t group_n_trial,
                                             double &err_at_percentile,
                                             double &max_err, double &avg_err) {
   double access_percentage = 0.9;
-  size_t record_n = keys.size();
   avg_err = 0;
   err_at_percentile = 0;
   max_err = 0;
@@ -193,8 +193,8 @@ void Root<key_t, val_t, seq, SearchClass>::calculate_err(const std::vector<key_t
               group_i < group_n_trial - 1);
 
     linear_model_t model;
-    model.prepare(keys.begin() + begin_i, end_i - begin_i);
-    double e = model.get_error_bound(keys.begin() + begin_i, end_i - begin_i);
+    model.prepare(keys + begin_i, end_i - begin_i);
+    double e = model.get_error_bound(keys + begin_i, end_i - begin_i);
     errors.push_back(e);
     avg_err += e;
   }
@@ -704,7 +704,7 @@ Root<key_t, val_t, seq, SearchClass>::locate_group_pt1(const key_t &key, int &gr
 
   // exponential search
   long long end_group_i = SearchClass::upper_bound(groups.get(), groups.get() + group_n, key, groups.get() + group_i,
-                           std::function<key_t(std::pair<key_t, group_t *volatile>*)>([&](std::pair<key_t, group_t *volatile>* it)->key_t{ return it->first; })) - groups.get() - 1;
+                           [&](std::pair<key_t, group_t *volatile>* it)->key_t{ return it->first; }) - groups.get() - 1;
 
   // int begin_group_i, end_group_i;
   // if (groups[group_i].first <= key) {
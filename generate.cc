@@ -1,9 +1,15 @@
+#include <atomic>
+#include <cmath>
 #include <iostream>
+#include <memory>
+#include <numeric>
 #include <random>
+#include <thread>
+#include <tuple>
 
 #include "util.h"
 #include "utils/cxxopts.hpp"
-#include "competitors/finedex/include/stx/btree_multimap.h"
+#include "utils/workload_format.h"
 
 using namespace std;
 
@@ -15,6 +21,8 @@ static mt19937_64 g(42);
 
 enum InsertPat { Equality = 0, Delta = 1, Hotspot = 2 };
 
+enum LookupDist { Uniform = 0, Zipf = 1, HotWindow = 2, Latest = 3, Sequential = 4 };
+
 vector<size_t> generate_permute(size_t lo, size_t hi, bool is_shuffle=false){
   vector<size_t> permute;
   permute.reserve(hi - lo);
@@ -49,32 +57,564 @@ vector<size_t> generate_permute_blockwise(size_t op_cnt, size_t insert_cnt, size
   return permute;
 }
 
+// Fenwick tree over `n` counters; prefix(i) sums the counters [0, i).
+template <class T>
+class Fenwick {
+ public:
+  // Builds the tree over `counters` in O(n).
+  explicit Fenwick(vector<T> counters) : tree_(counters.size() + 1, 0) {
+    for (size_t i = 1; i < tree_.size(); ++i){
+      tree_[i] += counters[i - 1];
+      const size_t parent = i + (i & -i);
+      if (parent < tree_.size()){
+        tree_[parent] += tree_[i];
+      }
+    }
+  }
+
+  void add(size_t i, T delta) {
+    for (++i; i < tree_.size(); i += i & -i){
+      tree_[i] += delta;
+    }
+  }
+
+  T prefix(size_t i) const {
+    T sum = 0;
+    for (; i > 0; i -= i & -i){
+      sum += tree_[i];
+    }
+    return sum;
+  }
+
+  // Largest i with prefix(i) <= target for non-negative counters; 
+  // `target` is reduced by prefix(i).
+  size_t search(T& target) const {
+    size_t pos = 0;
+    for (size_t step = size_t(1) << (63 - __builtin_clzll(tree_.size())); step > 0; step >>= 1){
+      if (pos + step < tree_.size() && tree_[pos + step] <= target){
+        pos += step;
+        target -= tree_[pos];
+      }
+    }
+    return pos;
+  }
+
+ private:
+  vector<T> tree_;
+};
+
+// Subset of a sorted array of pairs, kept as a bitmap with Fenwick-indexed 
+// per-word counts and value sums, so that the rank, the prefix sum of values 
+// and the select of a position all take O(log n).
+template <class KeyType>
+class VisibleSet {
+ public:
+  VisibleSet(const vector<KeyValue<KeyType>>& kvs, vector<uint64_t> words)
+      : kvs_(kvs), words_(std::move(words)), counts_(WordCounts(words_)), sums_(WordSums(kvs, words_)) {}
+
+  void set(size_t i) {
+    words_[i >> 6] |= 1ull << (i & 63);
+    counts_.add(i >> 6, 1);
+    sums_.add(i >> 6, kvs_[i].value);
+  }
+
+  // Unsigned deltas wrap around, so adding their negation subtracts them.
+  void reset(size_t i) {
+    words_[i >> 6] &= ~(1ull << (i & 63));
+    counts_.add(i >> 6, size_t(-1));
+    sums_.add(i >> 6, -kvs_[i].value);
+  }
+
+  bool test(size_t i) const { return (words_[i >> 6] >> (i & 63)) & 1; }
+
+  // Number of set positions < i.
+  size_t count(size_t i) const {
+    size_t cnt = counts_.prefix(i >> 6);
+    if (i & 63){
+      cnt += __builtin_popcountll(words_[i >> 6] & LowBits(i));
+    }
+    return cnt;
+  }
+
+  // Sum of the values at set positions < i.
+  uint64_t sum(size_t i) const {
+    uint64_t s = sums_.prefix(i >> 6);
+    if (i & 63){
+      for (uint64_t bits = words_[i >> 6] & LowBits(i); bits; bits &= bits - 1){
+        s += kvs_[(i & ~size_t(63)) | __builtin_ctzll(bits)].value;
+      }
+    }
+    return s;
+  }
+
+  // Position of the r-th set bit, counting from 0.
+  size_t select(size_t r) const {
+    const size_t w = counts_.search(r);
+    uint64_t bits = words_[w];
+    for (; r > 0; --r){
+      bits &= bits - 1;
+    }
+    return (w << 6) | __builtin_ctzll(bits);
+  }
+
+ private:
+  static uint64_t LowBits(size_t i) { return (1ull << (i & 63)) - 1; }
+
+  static vector<size_t> WordCounts(const vector<uint64_t>& words) {
+    vector<size_t> counts(words.size());
+    for (size_t w = 0; w < words.size(); ++w){
+      counts[w] = __builtin_popcountll(words[w]);
+    }
+    return counts;
+  }
+
+  static vector<uint64_t> WordSums(const vector<KeyValue<KeyType>>& kvs, const vector<uint64_t>& words) {
+    vector<uint64_t> sums(words.size(), 0);
+    for (size_t w = 0; w < words.size(); ++w){
+      for (uint64_t bits = words[w]; bits; bits &= bits - 1){
+        sums[w] += kvs[(w << 6) | __builtin_ctzll(bits)].value;
+      }
+    }
+    return sums;
+  }
+
+  const vector<KeyValue<KeyType>>& kvs_;
+  vector<uint64_t> words_;
+  Fenwick<size_t> counts_;
+  Fenwick<uint64_t> sums_;
+};
+
+// A delete of the workload: the key it removes, the thread issuing it, and
+// the pair's id, its position in the bulk loads followed by the inserts.
+template <class KeyType>
+struct Deletion {
+  KeyType key;
+  uint32_t owner;
+  size_t id;
+};
+
+// Sorted multiset of the pairs one thread sees while its workload is generated:
+// the bulk-loaded pairs, the inserts of all other threads, and the inserts the
+// thread itself has executed so far, minus the pairs it has deleted so far and
+// those other threads ever delete. Bulk loads and inserts are two sorted arrays
+// shared read-only by all threads; only the sets of visible pairs are per thread,
+// and bulk-loaded pairs only get one if the workload has deletes.
+// Equal keys order the bulk-loaded pairs first.
+template <class KeyType>
+class KeyView {
+ public:
+  // Position in the merged order: the numbers of bulk-loaded pairs and
+  // of inserts (visible or not) before it.
+  struct Bound {
+    size_t b, d;
+  };
+
+  // `base_sums` holds the prefix sums of the bulk-loaded values at every 
+  // multiple of 64, as returned by BlockSums().
+  // `deletions` holds the deletes of all threads.
+  KeyView(const vector<KeyValue<KeyType>>& base, const vector<uint64_t>& base_sums,
+          const vector<KeyValue<KeyType>>& inserts, const vector<uint32_t>& owners, uint32_t thread_id,
+          const vector<Deletion<KeyType>>& deletions)
+      : base_(base), base_sums_(base_sums), inserts_(inserts),
+        visible_(inserts, VisibleWords(owners, thread_id, base.size(), deletions)) {
+    if (!deletions.empty()){
+      vector<uint64_t> words((base.size() + 63) / 64, ~0ull);
+      if (base.size() % 64){
+        words.back() = (1ull << (base.size() % 64)) - 1;
+      }
+      for (const auto& deletion: deletions){
+        if (deletion.owner != thread_id && deletion.id < base.size()){
+          words[deletion.id >> 6] &= ~(1ull << (deletion.id & 63));
+        }
+      }
+      base_visible_.reset(new VisibleSet<KeyType>(base, std::move(words)));
+    }
+    size_ = BaseCount(base.size()) + visible_.count(inserts.size());
+  }
+
+  static vector<uint64_t> BlockSums(const vector<KeyValue<KeyType>>& base) {
+    vector<uint64_t> sums(base.size() / 64 + 1, 0);
+    uint64_t s = 0;
+    for (size_t i = 0; i < base.size(); ++i){
+      if (i % 64 == 0){
+        sums[i / 64] = s;
+      }
+      s += base[i].value;
+    }
+    if (base.size() % 64 == 0){
+      sums.back() = s;
+    }
+    return sums;
+  }
+
+  // Makes the insert at position pos of the insert array visible.
+  void insert(size_t pos) {
+    visible_.set(pos);
+    ++size_;
+  }
+
+  // Makes the visible pair of id `id` invisible.
+  void erase(size_t id) {
+    if (id < base_.size()){
+      base_visible_->reset(id);
+    }
+    else{
+      visible_.reset(id - base_.size());
+    }
+    --size_;
+  }
+
+  bool visible(size_t id) const {
+    if (id < base_.size()){
+      return !base_visible_ || base_visible_->test(id);
+    }
+    return visible_.test(id - base_.size());
+  }
+
+  size_t size() const { return size_; }
+
+  bool contains(const KeyType& key) const {
+    const Bound lo = lower_bound(key);
+    if (lo.b != base_.size() && base_[lo.b].key == key && visible(lo.b)){
+      return true;
+    }
+    const size_t cnt = visible_.count(lo.d);
+    if (cnt == visible_.count(inserts_.size())){
+      return false;
+    }
+    return inserts_[visible_.select(cnt)].key == key;
+  }
+
+  Bound lower_bound(const KeyType& key) const {
+    return {size_t(std::lower_bound(base_.begin(), base_.end(), key, KeyLess) - base_.begin()),
+            size_t(std::lower_bound(inserts_.begin(), inserts_.end(), key, KeyLess) - inserts_.begin())};
+  }
+
+  Bound upper_bound(const KeyType& key) const {
+    return {size_t(std::upper_bound(base_.begin(), base_.end(), key, KeyGreater) - base_.begin()),
+            size_t(std::upper_bound(inserts_.begin(), inserts_.end(), key, KeyGreater) - inserts_.begin())};
+  }
+
+  // Number of visible pairs before the bound.
+  size_t rank(const Bound& bound) const { return BaseCount(bound.b) + visible_.count(bound.d); }
+
+  // Sum of the values of the visible pairs before the bound.
+  uint64_t value_sum(const Bound& bound) const {
+    if (base_visible_){
+      return base_visible_->sum(bound.b) + visible_.sum(bound.d);
+    }
+    uint64_t s = base_sums_[bound.b / 64];
+    for (size_t i = bound.b & ~size_t(63); i < bound.b; ++i){
+      s += base_[i].value;
+    }
+    return s + visible_.sum(bound.d);
+  }
+
+  // The visible pair of rank r, in O(log^2 n).
+  const KeyValue<KeyType>& select(size_t r) const {
+    // Number of visible bulk-loaded pairs of rank <= r.
+    size_t lo = 0, hi = BaseCount(base_.size());
+    while (lo < hi){
+      const size_t mid = lo + (hi - lo) / 2;
+      if (BaseRank(BaseSelect(mid)) <= r){
+        lo = mid + 1;
+      }
+      else{
+        hi = mid;
+      }
+    }
+    if (lo > 0 && BaseRank(BaseSelect(lo - 1)) == r){
+      return base_[BaseSelect(lo - 1)];
+    }
+    return inserts_[visible_.select(r - lo)];
+  }
+
+ private:
+  // The inserts of other threads, minus those other threads delete.
+  static vector<uint64_t> VisibleWords(const vector<uint32_t>& owners, uint32_t thread_id,
+                                       size_t base_size, const vector<Deletion<KeyType>>& deletions) {
+    vector<uint64_t> words((owners.size() + 63) / 64, 0);
+    for (size_t i = 0; i < owners.size(); ++i){
+      if (owners[i] != thread_id){
+        words[i >> 6] |= 1ull << (i & 63);
+      }
+    }
+    for (const auto& deletion: deletions){
+      if (deletion.owner != thread_id && deletion.id >= base_size){
+        const size_t i = deletion.id - base_size;
+        words[i >> 6] &= ~(1ull << (i & 63));
+      }
+    }
+    return words;
+  }
+
+  // Number of visible bulk-loaded pairs before position b.
+  size_t BaseCount(size_t b) const { return base_visible_ ? base_visible_->count(b) : b; }
+
+  // Position of the visible bulk-loaded pair of rank k among them.
+  size_t BaseSelect(size_t k) const { return base_visible_ ? base_visible_->select(k) : k; }
+
+  // Rank of the visible bulk-loaded pair at position b.
+  size_t BaseRank(size_t b) const {
+    const size_t d = std::lower_bound(inserts_.begin(), inserts_.end(), base_[b].key, KeyLess) - inserts_.begin();
+    return BaseCount(b) + visible_.count(d);
+  }
+
+  static bool KeyLess(const KeyValue<KeyType>& lhs, const KeyType& lookup_key) {
+    return lhs.key < lookup_key;
+  }
+
+  static bool KeyGreater(const KeyType& lookup_key, const KeyValue<KeyType>& rhs) {
+    return lookup_key < rhs.key;
+  }
+
+  const vector<KeyValue<KeyType>>& base_;
+  const vector<uint64_t>& base_sums_;
+  const vector<KeyValue<KeyType>>& inserts_;
+  VisibleSet<KeyType> visible_;
+  // Visible bulk-loaded pairs, if the workload has deletes.
+  unique_ptr<VisibleSet<KeyType>> base_visible_;
+  size_t size_;
+};
+
+// Zipf-distributed ranks in [0, n), rank 0 being the most frequent, drawn in
+// O(1) following Gray et al., "Quickly Generating Billion-Record Synthetic
+// Databases", which needs 0 < theta < 1. n may grow, as zeta(n) is then
+// extended term by term.
+class ZipfRanks {
+ public:
+  ZipfRanks(size_t n, double theta, double zeta_n)
+      : n_(n), theta_(theta), alpha_(1 / (1 - theta)), zeta_n_(zeta_n),
+        half_pow_theta_(pow(0.5, theta)) {
+    Refresh();
+  }
+
+  static double Zeta(size_t n, double theta) {
+    double sum = 0;
+    for (size_t i = 1; i <= n; i ++){
+      sum += pow(double(i), -theta);
+    }
+    return sum;
+  }
+
+  void grow(size_t n) {
+    if (n <= n_){
+      return;
+    }
+    for (; n_ < n; n_ ++){
+      zeta_n_ += pow(double(n_ + 1), -theta_);
+    }
+    Refresh();
+  }
+
+  size_t operator()(util::FastRandom& ranny) const {
+    const double u = ranny.RandUint32() / 4294967296.0, uz = u * zeta_n_;
+    if (uz < 1){
+      return 0;
+    }
+    if (uz < 1 + half_pow_theta_){
+      return std::min<size_t>(1, n_ - 1);
+    }
+    return std::min<size_t>(n_ * pow(eta_ * u - eta_ + 1, alpha_), n_ - 1);
+  }
+
+ private:
+  void Refresh() {
+    eta_ = (1 - pow(2.0 / n_, 1 - theta_)) / (1 - (1 + half_pow_theta_) / zeta_n_);
+  }
+
+  size_t n_;
+  double theta_, alpha_, zeta_n_, half_pow_theta_, eta_;
+};
+
+// Draws the offsets of the keys positive lookups target, among the bulk
+// loads (in key order) followed by the inserts of the thread (in operation
+// order), of which there are `data_size` so far. `param` is
+//   Zipf: theta; ranks are scattered over the bulk loads by a stride
+//     coprime to their number, the inserts taking the coldest ranks,
+//   HotWindow: the share of the bulk loads, from 30% of them on like the
+//     hotspot insert pattern, that takes all lookups,
+//   Latest: theta of a Zipf distribution over the offsets, the latest
+//     insert being the most frequent,
+//   Sequential: the length of the runs of consecutive bulk-loaded keys,
+//     each starting at a uniformly drawn one.
+// Drawing again after an offset that is not visible moves on within a run.
+class LookupOffsets {
+ public:
+  // `zeta` is ZipfRanks::Zeta(bulk_size, param), for Zipf and Latest.
+  LookupOffsets(LookupDist dist, double param, size_t bulk_size, double zeta)
+      : dist_(dist), bulk_size_(bulk_size) {
+    if (dist == LookupDist::Zipf || dist == LookupDist::Latest){
+      zipf_.reset(new ZipfRanks(bulk_size, param, zeta));
+      stride_ = 0.6180339887 * bulk_size;
+      while (std::gcd(stride_, bulk_size) != 1){
+        ++stride_;
+      }
+    }
+    else if (dist == LookupDist::HotWindow){
+      window_size_ = std::max<size_t>(1, param * bulk_size);
+      window_lo_ = std::min<size_t>(0.3 * bulk_size, bulk_size - window_size_);
+    }
+    else if (dist == LookupDist::Sequential){
+      run_length_ = std::max<size_t>(1, param);
+    }
+  }
+
+  size_t operator()(util::FastRandom& ranny, size_t data_size) {
+    switch (dist_) {
+      case LookupDist::Zipf: {
+        zipf_->grow(data_size);
+        const size_t rank = (*zipf_)(ranny);
+        return rank < bulk_size_ ? rank * stride_ % bulk_size_ : rank;
+      }
+      case LookupDist::HotWindow: {
+        return window_lo_ + ranny.RandUint32(0, window_size_ - 1);
+      }
+      case LookupDist::Latest: {
+        zipf_->grow(data_size);
+        return data_size - 1 - (*zipf_)(ranny);
+      }
+      case LookupDist::Sequential: {
+        if (run_left_ == 0){
+          run_left_ = run_length_;
+          offset_ = ranny.RandUint32(0, bulk_size_ - 1);
+        }
+        else{
+          offset_ = (offset_ + 1) % bulk_size_;
+        }
+        --run_left_;
+        return offset_;
+      }
+      default: {
+        return ranny.RandUint32(0, data_size - 1);
+      }
+    }
+  }
+
+ private:
+  const LookupDist dist_;
+  const size_t bulk_size_;
+  unique_ptr<ZipfRanks> zipf_;
+  size_t stride_ = 1;
+  size_t window_lo_ = 0, window_size_ = 0;
+  size_t run_length_ = 0, run_left_ = 0, offset_ = 0;
+};
+
+// Pick the pairs the deletes and updates of a thread target. A thread only
+// writes pairs it owns, so that what its lookups expect does not depend on 
+// the interleaving of threads: the bulk-loaded pairs at positions congruent
+// to `thread_id` modulo `thread_num`, and its own inserts once executed.
+// A `recent_delete_ratio` share of the deletes removes the latest insert of
+// the thread still present, the others a uniformly drawn owned pair.
+// `delete_ids` receives the ids of the deleted pairs, in operation order.
+template <class KeyType>
+void generate_writes(vector<Operation<KeyType>>& ops, util::FastRandom& ranny,
+    const vector<KeyValue<KeyType>>& bulk_loads, const vector<KeyValue<KeyType>>& inserts,
+    const vector<size_t>& insert_pos, const size_t thread_id, const size_t thread_num,
+    const double recent_delete_ratio, vector<size_t>& delete_ids) {
+  // Owned pairs are numbered from 0: the bulk-loaded ones, then the inserts.
+  const size_t owned_cnt = (bulk_loads.size() + thread_num - 1 - thread_id) / thread_num;
+  vector<bool> removed(owned_cnt + insert_pos.size(), false);
+  size_t executed = 0;
+  // Own inserts executed so far, latest last; deleted ones are dropped lazily.
+  vector<size_t> recent;
+
+  auto id_of = [&](size_t owned) -> size_t {
+    return owned < owned_cnt ? thread_id + owned * thread_num : bulk_loads.size() + insert_pos[owned - owned_cnt];
+  };
+  auto draw = [&]() -> size_t {
+    for (size_t num_retries = 0; owned_cnt + executed > 0 && num_retries < max_num_retries; ++num_retries){
+      const size_t owned = ranny.RandUint32(0, owned_cnt + executed - 1);
+      if (!removed[owned]){
+        return owned;
+      }
+    }
+    util::fail("Generate_writes: exceeded max number of retries");
+    return 0;
+  };
+
+  for (auto& op: ops){
+    if (op.op == util::INSERT){
+      recent.push_back(owned_cnt + executed ++);
+      continue;
+    }
+    if (op.op != util::DELETE && op.op != util::UPDATE){
+      continue;
+    }
+    size_t owned;
+    if (op.op == util::DELETE && recent_delete_ratio > 0 && ranny.ScaleFactor() < recent_delete_ratio){
+      while (!recent.empty() && removed[recent.back()]){
+        recent.pop_back();
+      }
+      owned = recent.empty() ? draw() : recent.back();
+    }
+    else{
+      owned = draw();
+    }
+    const size_t id = id_of(owned);
+    const KeyValue<KeyType>& kv = id < bulk_loads.size() ? bulk_loads[id] : inserts[id - bulk_loads.size()];
+    op.lo_key = kv.key;
+    if (op.op == util::DELETE){
+      removed[owned] = true;
+      delete_ids.push_back(id);
+    }
+    else{
+      // Lookups are verified against the positions of the keys in the dataset,
+      // which values are, so an update writes the same value anew.
+      op.result = kv.value;
+    }
+  }
+}
+
 // Generate queries compatible with `negative_lookup_ratio` 
 // and `range_query_ratio`, and ensure that range query never
 // scans more than `max_num` pairs.
+// `view` holds the pairs visible to the thread; `insert_pos` holds the 
+// positions of the thread's inserts in the shared insert array, in operation order,
+// and `delete_ids` the ids of the pairs its deletes remove.
+// Positive lookups are drawn by `offsets` from the bulk loads and the thread's 
+// own inserts that are visible; negative ones also avoid the keys other threads 
+// delete. Unless lookups are uniform, negative ones fall in the gap after a key 
+// `offsets` draws, so that they follow the same skew.
 template <class KeyType>
 void generate_equality_lookups(const string& filename, vector<Operation<KeyType>>& ops, util::FastRandom& ranny,
-    std::multimap<KeyType, uint64_t>& data_map, vector<KeyValue<KeyType>>& data_vec,
-    const double negative_lookup_ratio, bool is_insert, const size_t max_num = 100, const double error = 0.05) {
+    KeyView<KeyType>& view, const vector<KeyValue<KeyType>>& bulk_loads, const vector<size_t>& insert_pos,
+    const vector<size_t>& delete_ids, const vector<Deletion<KeyType>>& deletions, const uint32_t thread_id,
+    const double negative_lookup_ratio, const LookupDist dist, LookupOffsets& offsets,
+    const size_t max_num = 100, const double error = 0.05) {
+  vector<KeyType> own_inserts;
+  own_inserts.reserve(insert_pos.size());
+  size_t data_size = bulk_loads.size(), delete_cnt = 0;
+  // Draws the key at `offset` of the bulk loads followed by the thread's own inserts.
+  auto data_key = [&](size_t offset) -> KeyType {
+    return offset < bulk_loads.size() ? bulk_loads[offset].key : own_inserts[offset - bulk_loads.size()];
+  };
+  auto data_id = [&](size_t offset) -> size_t {
+    return offset < bulk_loads.size() ? offset : bulk_loads.size() + insert_pos[offset - bulk_loads.size()];
+  };
+  // Whether another thread deletes `key`, so that lookups can not expect it either way.
+  auto deleted_by_other = [&](const KeyType& key) {
+    auto it = std::lower_bound(deletions.begin(), deletions.end(), key,
+                               [](const Deletion<KeyType>& d, const KeyType& k) { return d.key < k; });
+    return it != deletions.end() && it->key == key && it->owner != thread_id;
+  };
+
   for (size_t i = 0; i < ops.size(); i ++){
     if (ops[i].op == util::INSERT){
-      data_map.emplace(static_cast<KeyType>(ops[i].lo_key), static_cast<uint64_t>(ops[i].result));
-      KeyValue<KeyType> kv;
-      kv.key = ops[i].lo_key;
-      kv.value = ops[i].result;
-      data_vec.push_back(kv);
+      view.insert(insert_pos[own_inserts.size()]);
+      own_inserts.push_back(ops[i].lo_key);
+      ++data_size;
+      continue;
+    }
+    if (ops[i].op == util::DELETE){
+      view.erase(delete_ids[delete_cnt ++]);
+      continue;
+    }
+    if (ops[i].op == util::UPDATE){
       continue;
     }
     if (ops[i].op == util::LOOKUP){
-      KeyType min_key, max_key;
-      if (is_insert){
-        min_key = data_map.begin()->first;
-        max_key = data_map.rbegin()->first;
-      } 
-      else{
-        min_key = data_vec[0].key;
-        max_key = data_vec[data_vec.size() - 1].key;
-      }
+      KeyType min_key = view.select(0).key, max_key = view.select(view.size() - 1).key;
 
       if constexpr (std::is_same<KeyType, uint64_t>::value){
         if (filename.find("fb_200M_uint64") != std::string::npos && max_key > 77308821508){
@@ -88,18 +628,25 @@ void generate_equality_lookups(const string& filename, vector<Operation<KeyType>
           // Generate negative lookup.
           KeyType negative_lookup;
           bool is_exist = true;
+          size_t num_retries = 0;
           while (is_exist) {
-            // Draw lookup key from data domain.
-            negative_lookup = (ranny.ScaleFactor() * (max_key - min_key)) + min_key;
-            if (is_insert){
-              is_exist = data_map.find(negative_lookup) != data_map.end();
+            if (dist == LookupDist::Uniform){
+              // Draw lookup key from data domain.
+              negative_lookup = (ranny.ScaleFactor() * (max_key - min_key)) + min_key;
             }
             else{
-              auto it = std::lower_bound(data_vec.begin(), data_vec.end(), negative_lookup, [](const KeyValue<KeyType>& lhs, const KeyType& lookup_key) {
-                           return lhs.key < lookup_key;
-                         });
-              is_exist = it != data_vec.end() && it->key == negative_lookup;
+              if (++num_retries > max_num_retries)
+                util::fail("Generate_equality_lookups: exceeded max number of retries");
+              // Draw lookup key between a drawn key and the next visible one.
+              const KeyType key = data_key(offsets(ranny, data_size));
+              const size_t next = view.rank(view.upper_bound(key));
+              const KeyType next_key = next < view.size() ? std::min(view.select(next).key, max_key) : max_key;
+              if (key >= next_key || next_key - key < 2){
+                continue;
+              }
+              negative_lookup = key + 1 + KeyType(ranny.ScaleFactor() * (next_key - key - 2));
             }
+            is_exist = view.contains(negative_lookup) || deleted_by_other(negative_lookup);
           }
           ops[i].lo_key = negative_lookup;
           ops[i].result = util::NOT_FOUND;
@@ -110,8 +657,13 @@ void generate_equality_lookups(const string& filename, vector<Operation<KeyType>
       // Generate positive lookup.
 
       // Draw lookup key from existing keys.
-      const uint64_t offset = ranny.RandUint32(0, data_vec.size() - 1);
-      const KeyType lookup_key = data_vec[offset].key;
+      uint64_t offset = offsets(ranny, data_size);
+      for (size_t num_retries = 0; !view.visible(data_id(offset)); ++num_retries){
+        if (num_retries > max_num_retries)
+          util::fail("Generate_equality_lookups: exceeded max number of retries");
+        offset = offsets(ranny, data_size);
+      }
+      const KeyType lookup_key = data_key(offset);
       ops[i].lo_key = lookup_key;
       ops[i].result = 0;
       continue;
@@ -125,23 +677,13 @@ void generate_equality_lookups(const string& filename, vector<Operation<KeyType>
       uint64_t result;
 
       while(!generated){
-        KeyType min_key, max_key; 
-        if (is_insert){
-          min_key = data_map.begin()->first;
-          auto tmp_it = data_map.end();
-          advance(tmp_it, - max_num - 1);
-          max_key = tmp_it->first;
-        }
-        else{
-          min_key = data_vec[0].key;
-          max_key = data_vec[data_vec.size() - max_num - 1].key;
-        }
+        KeyType min_key = view.select(0).key, max_key = view.select(view.size() - max_num - 1).key;
 
         // Draw lookup key from data domain.
         if constexpr (std::is_same<KeyType, std::string>::value) {
           while(true){
-            const uint64_t offset = ranny.RandUint32(0, data_vec.size() - 1);
-            lo_key = data_vec[offset].key;
+            const uint64_t offset = ranny.RandUint32(0, data_size - 1);
+            lo_key = data_key(offset);
             if (lo_key > max_key){
               ++num_retries;
               if (num_retries > max_num_retries)
@@ -155,31 +697,15 @@ void generate_equality_lookups(const string& filename, vector<Operation<KeyType>
           lo_key = (ranny.ScaleFactor() * (max_key - min_key)) + min_key;
         }
 
+        const auto lo = view.lower_bound(lo_key);
+        const size_t lo_rank = view.rank(lo), hi_rank = lo_rank + size_t((1 - ranny.ScaleFactor() * error) * max_num);
         num_qualifying = 0;
         result = 0;
-        if (is_insert){
-          auto lo = data_map.lower_bound(lo_key);
-        
-          auto tmp_it = lo;
-          advance(tmp_it, (1 - ranny.ScaleFactor() * error) * max_num);
-          hi_key = tmp_it->first;
-          
-          while (lo != data_map.end() && lo->first <= hi_key) {
-            result += lo->second;
-            ++num_qualifying;
-            ++lo;
-          }
-        }
-        else{
-          auto it = std::lower_bound(data_vec.begin(), data_vec.end(), lo_key, [](const KeyValue<KeyType>& lhs, const KeyType& lookup_key) {
-                            return lhs.key < lookup_key;
-                          });
-          hi_key = (it + (1 - ranny.ScaleFactor() * error) * max_num)->key;
-          while(it != data_vec.end() && it->key <= hi_key){
-            result += it->value;
-            ++num_qualifying;
-            ++it;
-          }
+        if (hi_rank < view.size()){
+          hi_key = view.select(hi_rank).key;
+          const auto hi = view.upper_bound(hi_key);
+          num_qualifying = view.rank(hi) - lo_rank;
+          result = view.value_sum(hi) - view.value_sum(lo);
         }
 
         if (num_qualifying > max_num || num_qualifying < min_num) {
@@ -280,7 +806,7 @@ template <class KeyType>
 void print_op_stats(
   vector<Operation<KeyType>> const* ops, size_t thread_num) {
   for (size_t i = 0; i < thread_num; i ++){
-    size_t negative_count = 0, lookup_count = 0, rq_count = 0, insert_count = 0;
+    size_t negative_count = 0, lookup_count = 0, rq_count = 0, insert_count = 0, delete_count = 0, update_count = 0;
     for (const auto& op: ops[i]){
       if (op.op == util::LOOKUP){
         if (op.result == util::NOT_FOUND){
@@ -297,25 +823,39 @@ void print_op_stats(
         ++insert_count;
         continue;
       }
+      if (op.op == util::DELETE){
+        ++delete_count;
+        continue;
+      }
+      if (op.op == util::UPDATE){
+        ++update_count;
+        continue;
+      }
     }
     cout << "Thread's operation count: " << ops[i].size() << endl;
     cout << "Negative lookup ratio: " << static_cast<double>(negative_count) / lookup_count << endl;
     cout << "Range query ratio: " << static_cast<double>(rq_count) / ops[i].size() << endl;
     cout << "Insert ratio: " << static_cast<double>(insert_count) / ops[i].size() << endl;
+    cout << "Delete ratio: " << static_cast<double>(delete_count) / ops[i].size() << endl;
+    cout << "Update ratio: " << static_cast<double>(update_count) / ops[i].size() << endl;
   }
 }
 
 template <class KeyType>
 void generate(const string& filename, size_t op_cnt, 
               double range_query_ratio, double negative_lookup_ratio, double insert_ratio,
-              InsertPat pat, double hotspot_ratio, 
-              size_t thread_num, bool mix, size_t block_num, size_t bulkload_cnt){
+              double delete_ratio, double update_ratio, double recent_delete_ratio,
+              InsertPat pat, double hotspot_ratio, LookupDist lookup_dist, double lookup_param,
+              size_t thread_num, bool mix, size_t block_num, size_t bulkload_cnt, size_t num_jobs,
+              size_t chunk_size){
   util::FastRandom ranny(42);
   // Load data.
-  const vector<KeyType> keys = util::load_data<KeyType>(filename);
+  const util::DataSpan<KeyType> keys = util::map_data<KeyType>(filename);
 
   if (!is_sorted(keys.begin(), keys.end()))
     util::fail("Keys have to be sorted.");
+  if ((delete_ratio > 0 || update_ratio > 0) && adjacent_find(keys.begin(), keys.end()) != keys.end())
+    util::fail("Deletes and updates need unique keys.");
 
   // Generate name for workload.
   string op_filename = filename + "_ops_" + to_nice_number(op_cnt) + "_" 
@@ -326,6 +866,15 @@ void generate(const string& filename, size_t op_cnt,
     op_filename += "_" + to_string(pat) + "m";
   if (pat == InsertPat::Hotspot)
     op_filename += "_" + to_string(hotspot_ratio) + "h";
+  if (delete_ratio > 0){
+    op_filename += "_" + to_string(delete_ratio) + "d";
+    if (recent_delete_ratio > 0)
+      op_filename += "_" + to_string(recent_delete_ratio) + "rd";
+  }
+  if (update_ratio > 0)
+    op_filename += "_" + to_string(update_ratio) + "u";
+  if (lookup_dist != LookupDist::Uniform)
+    op_filename += "_" + to_string(lookup_dist) + "ld_" + to_string(lookup_param) + "lp";
   if (thread_num > 1){
     op_filename += "_" + to_string(thread_num) + "t";
   }
@@ -347,13 +896,15 @@ void generate(const string& filename, size_t op_cnt,
   if (bulkload_cnt != size_t(-1) && insert_cnt + bulkload_cnt > keys.size()){
     util::fail("Insert number + Bulk-loaded number > Dataset size");
   }
+  const size_t delete_cnt = op_cnt * delete_ratio, update_cnt = op_cnt * update_ratio;
+  const size_t write_cnt = insert_cnt + delete_cnt + update_cnt;
   size_t range_query_cnt = 0, lookup_cnt = 0; 
-  if (insert_ratio + range_query_ratio >= 1.){
-    range_query_cnt = op_cnt - insert_cnt;
+  if (insert_ratio + delete_ratio + update_ratio + range_query_ratio >= 1.){
+    range_query_cnt = op_cnt - write_cnt;
   }
   else{
     range_query_cnt = op_cnt * range_query_ratio;
-    lookup_cnt = op_cnt - insert_cnt - range_query_cnt;
+    lookup_cnt = op_cnt - write_cnt - range_query_cnt;
   }
   
   vector<KeyValue<KeyType>> bulk_loads;
@@ -381,62 +932,155 @@ void generate(const string& filename, size_t op_cnt,
     bulk_loads.swap(org_vec);
   }
 
-  for (size_t j = insert_cnt; j < insert_cnt + lookup_cnt; j ++){
+  // Without --mix, deletes and updates follow the inserts.
+  for (size_t j = insert_cnt; j < insert_cnt + delete_cnt; j ++){
+    tot_ops[op_id[j]].op = util::DELETE;
+  }
+  for (size_t j = insert_cnt + delete_cnt; j < write_cnt; j ++){
+    tot_ops[op_id[j]].op = util::UPDATE;
+  }
+  for (size_t j = write_cnt; j < write_cnt + lookup_cnt; j ++){
     tot_ops[op_id[j]].op = util::LOOKUP;
   }
-  for (size_t j = insert_cnt + lookup_cnt; j < op_cnt; j ++){
+  for (size_t j = write_cnt + lookup_cnt; j < op_cnt; j ++){
     tot_ops[op_id[j]].op = util::RANGE_QUERY;
   }
 
-  vector<pair<KeyType, uint64_t>> insert_vecs[thread_num];
   vector<Operation<KeyType>> ops[thread_num];
   if (thread_num > 1){
     for (const auto& e: tot_ops){
       size_t i = ranny.RandUint32(0, thread_num - 1);
       ops[i].push_back(e);
-      if (e.op == util::INSERT){
-        insert_vecs[i].emplace_back(e.lo_key, e.result);
-      }
     }
   }
   else{
     ops[0] = tot_ops;
   }
 
-
+  // Sort the inserts of all threads once; every thread sees those of the other 
+  // threads from the start and its own ones as it executes them.
+  vector<tuple<KeyType, uint32_t, size_t, uint64_t>> sorted_inserts;
+  sorted_inserts.reserve(insert_cnt);
   for (size_t i = 0; i < thread_num; i ++){
-    // Generate workload.
-    
-    vector<KeyValue<KeyType>> data_vec = bulk_loads;
-    std::multimap<KeyType, uint64_t> data_map;
-    if (insert_ratio > 0){
-      vector<std::pair<KeyType, uint64_t>> other_vec;
-      for (const auto& kv: bulk_loads){
-        other_vec.emplace_back(kv.key, kv.value);
-      }
-      for (size_t j = 0; j < thread_num; ++ j){
-        if (j == i){
-          continue;
-        }
-        other_vec.insert(other_vec.end(), insert_vecs[j].begin(), insert_vecs[j].end());
+    size_t seq = 0;
+    for (const auto& e: ops[i]){
+      if (e.op == util::INSERT){
+        sorted_inserts.emplace_back(e.lo_key, i, seq ++, e.result);
       }
-      if (thread_num > 1){
-        sort(other_vec.begin(), other_vec.end());
+    }
+  }
+  sort(sorted_inserts.begin(), sorted_inserts.end());
+  vector<KeyValue<KeyType>> inserts(sorted_inserts.size());
+  vector<uint32_t> owners(sorted_inserts.size());
+  vector<size_t> insert_pos[thread_num];
+  for (size_t i = 0; i < thread_num; i ++){
+    insert_pos[i].reserve(insert_cnt / thread_num);
+  }
+  for (size_t j = 0; j < sorted_inserts.size(); j ++){
+    inserts[j].key = get<0>(sorted_inserts[j]);
+    inserts[j].value = get<3>(sorted_inserts[j]);
+    owners[j] = get<1>(sorted_inserts[j]);
+    auto& pos = insert_pos[owners[j]];
+    const size_t seq = get<2>(sorted_inserts[j]);
+    if (pos.size() <= seq){
+      pos.resize(seq + 1);
+    }
+    pos[seq] = j;
+  }
+  vector<tuple<KeyType, uint32_t, size_t, uint64_t>>().swap(sorted_inserts);
+  const vector<uint64_t> base_sums = KeyView<KeyType>::BlockSums(bulk_loads);
+
+  // Every thread draws from its own random stream so that threads are 
+  // generated in parallel, and the output does not depend on `num_jobs`.
+  vector<util::FastRandom> rannies;
+  if (thread_num > 1){
+    for (size_t i = 0; i < thread_num; i ++){
+      rannies.emplace_back((uint64_t(ranny.RandUint32()) << 32) | ranny.RandUint32() | 1);
+    }
+  }
+
+  // Runs generate_thread(i) for every thread i.
+  num_jobs = std::max<size_t>(1, std::min(num_jobs, thread_num));
+  auto for_each_thread = [&](auto generate_thread) {
+    if (num_jobs == 1){
+      for (size_t i = 0; i < thread_num; i ++){
+        generate_thread(i);
       }
-      auto it = data_map.begin();
-      for (const auto& e: other_vec){
-        it = data_map.insert(it, e);
+      return;
+    }
+    std::atomic<size_t> next_thread(0);
+    vector<std::thread> workers;
+    for (size_t j = 0; j < num_jobs; j ++){
+      workers.emplace_back([&]() {
+        size_t i;
+        while ((i = next_thread.fetch_add(1)) < thread_num){
+          generate_thread(i);
+        }
+      });
+    }
+    for (auto& worker: workers){
+      worker.join();
+    }
+  };
+
+  // Deletes are picked first, as every thread sees those of the others.
+  vector<size_t> delete_ids[thread_num];
+  vector<Deletion<KeyType>> deletions;
+  if (delete_cnt + update_cnt > 0){
+    for_each_thread([&](size_t i) {
+      generate_writes(ops[i], thread_num > 1 ? rannies[i] : ranny, bulk_loads, inserts,
+        insert_pos[i], i, thread_num, recent_delete_ratio, delete_ids[i]);
+    });
+    deletions.reserve(delete_cnt);
+    for (size_t i = 0; i < thread_num; i ++){
+      for (const size_t id: delete_ids[i]){
+        const KeyType& key = id < bulk_loads.size() ? bulk_loads[id].key : inserts[id - bulk_loads.size()].key;
+        deletions.push_back({key, uint32_t(i), id});
       }
     }
-    
-    generate_equality_lookups(filename, ops[i], ranny,
-      data_map, data_vec, negative_lookup_ratio, insert_ratio > 0);
+    sort(deletions.begin(), deletions.end(), [](const Deletion<KeyType>& lhs, const Deletion<KeyType>& rhs) {
+      return lhs.key < rhs.key;
+    });
+  }
+
+  double zeta = 0;
+  if (lookup_dist == LookupDist::Zipf || lookup_dist == LookupDist::Latest){
+    zeta = ZipfRanks::Zeta(bulk_loads.size(), lookup_param);
   }
+  for_each_thread([&](size_t i) {
+    KeyView<KeyType> view(bulk_loads, base_sums, inserts, owners, i, deletions);
+    LookupOffsets offsets(lookup_dist, lookup_param, bulk_loads.size(), zeta);
+    generate_equality_lookups(filename, ops[i], thread_num > 1 ? rannies[i] : ranny,
+      view, bulk_loads, insert_pos[i], delete_ids[i], deletions, i, negative_lookup_ratio,
+      lookup_dist, offsets);
+  });
   print_op_stats(ops, thread_num);
 
   if (insert_ratio > 0 || bulkload_cnt != size_t(-1)){
     util::write_data(bulk_loads, bulkload_filename);
   }
+  if constexpr (!std::is_same<KeyType, std::string>::value){
+    if (chunk_size > 0){
+      util::WorkloadHeader header = {};
+      header.num_blocks = block_num;
+      header.chunk_size = chunk_size;
+      header.op_count = op_cnt;
+      header.bulkload_count = bulkload_cnt;
+      header.range_query_ratio = range_query_ratio;
+      header.negative_lookup_ratio = negative_lookup_ratio;
+      header.insert_ratio = insert_ratio;
+      header.delete_ratio = delete_ratio;
+      header.update_ratio = update_ratio;
+      header.recent_delete_ratio = recent_delete_ratio;
+      header.hotspot_ratio = hotspot_ratio;
+      header.insert_pattern = pat;
+      header.mix = mix;
+      header.lookup_distribution = lookup_dist;
+      header.lookup_param = lookup_param;
+      util::write_workload(ops, thread_num, header, op_filename);
+      return;
+    }
+  }
   if (thread_num > 1){
     util::write_data_multithread(ops, thread_num, op_filename);
   }
@@ -456,6 +1100,8 @@ int main(int argc, char* argv[]) {
                                cxxopts::value<double>()->default_value("0"))(
       "t,thread", "Number of threads", 
                                cxxopts::value<size_t>()->default_value("1"))(
+      "j,jobs", "Number of threads used to generate the workload", 
+                               cxxopts::value<size_t>()->default_value(to_string(std::thread::hardware_concurrency())))(
       "s,scan-ratio", "Range query ratio", 
                                cxxopts::value<double>()->default_value("0"))(
       "i,insert-ratio", "Insert ratio", 
@@ -464,9 +1110,23 @@ int main(int argc, char* argv[]) {
                                cxxopts::value<string>()->default_value("equality"))(
       "h,hotspot-ratio", "Hotspot ratio",
                                cxxopts::value<double>()->default_value("0.1"))(
+      "d,delete-ratio", "Delete ratio", 
+                               cxxopts::value<double>()->default_value("0"))(
+      "u,update-ratio", "Update ratio", 
+                               cxxopts::value<double>()->default_value("0"))(
+      "recent-delete-ratio", "Share of the deletes removing the latest insert of their thread",
+                               cxxopts::value<double>()->default_value("0"))(
+      "l,lookup-distribution", "Distribution of lookup keys, one of: uniform, zipf, hotspot, latest, sequential",
+                               cxxopts::value<string>()->default_value("uniform"))(
+      "lookup-param", "Zipf theta for zipf and latest (0.99), hot share of the keys for hotspot (0.1), "
+                      "run length for sequential (100)",
+                               cxxopts::value<double>())(
       "mix", "Mix lookups, range queries and inserts together")(
       "block", "Divide workload into several blocks, number of blocks", 
-                               cxxopts::value<size_t>()->default_value("1"));
+                               cxxopts::value<size_t>()->default_value("1"))(
+      "columnar", "Write operations in the compressed columnar format")(
+      "chunk-size", "Operations per chunk of the columnar format", 
+                               cxxopts::value<size_t>()->default_value(to_string(util::kDefaultChunkSize)));
 
   options.parse_positional({"data", "operation-count"});
 
@@ -483,16 +1143,27 @@ int main(int argc, char* argv[]) {
   const DataType type = util::resolve_type(filename);
   size_t op_cnt = result["operation-count"].as<size_t>();
   size_t thread_num = result["thread"].as<size_t>();
+  size_t num_jobs = result["jobs"].as<size_t>();
   size_t block_num = result["block"].as<size_t>();
   if (block_num > 1 && (thread_num > 1 || mix)) {
     util::fail(
         "Can not use block-wise loading mode with multi-thread or mixed scenario.");
   }
   size_t bulkload_cnt = result["bulkload-count"].as<size_t>();
+  size_t chunk_size = result.count("columnar") ? result["chunk-size"].as<size_t>() : 0;
+  if (result.count("columnar") && (type == DataType::STRING || chunk_size == 0)) {
+    util::fail("Columnar workloads need fixed-width keys and a positive chunk size.");
+  }
   double range_query_ratio = result["scan-ratio"].as<double>(), 
          negative_lookup_ratio = result["negative-lookup-ratio"].as<double>(),
          insert_ratio = result["insert-ratio"].as<double>(),
+         delete_ratio = result["delete-ratio"].as<double>(),
+         update_ratio = result["update-ratio"].as<double>(),
+         recent_delete_ratio = result["recent-delete-ratio"].as<double>(),
          hotspot_ratio = result["hotspot-ratio"].as<double>();
+  if (block_num > 1 && (delete_ratio > 0 || update_ratio > 0)) {
+    util::fail("Can not use block-wise loading mode with deletes or updates.");
+  }
 
   InsertPat pat = InsertPat::Equality; 
   if (insert_ratio > 0){
@@ -509,9 +1180,40 @@ int main(int argc, char* argv[]) {
     }
   }
 
+  LookupDist lookup_dist = LookupDist::Uniform;
+  double lookup_param = 0;
+  const string dist_str = result["lookup-distribution"].as<string>();
+  if (dist_str == "uniform") {}
+  else if (dist_str == "zipf" || dist_str == "latest"){
+    lookup_dist = dist_str == "zipf" ? LookupDist::Zipf : LookupDist::Latest;
+    lookup_param = result.count("lookup-param") ? result["lookup-param"].as<double>() : 0.99;
+    if (lookup_param <= 0 || lookup_param >= 1){
+      util::fail("Zipf theta must be between 0 and 1.");
+    }
+  }
+  else if (dist_str == "hotspot"){
+    lookup_dist = LookupDist::HotWindow;
+    lookup_param = result.count("lookup-param") ? result["lookup-param"].as<double>() : 0.1;
+    if (lookup_param <= 0 || lookup_param > 1){
+      util::fail("Lookup hotspot ratio must be between 0 and 1.");
+    }
+  }
+  else if (dist_str == "sequential"){
+    lookup_dist = LookupDist::Sequential;
+    lookup_param = result.count("lookup-param") ? std::floor(result["lookup-param"].as<double>()) : 100;
+    if (lookup_param < 1){
+      util::fail("Sequential lookup runs need at least one key.");
+    }
+  }
+  else {
+    util::fail("undefined lookup distribution found.");
+  }
+
   if (negative_lookup_ratio < 0 || negative_lookup_ratio > 1
   || range_query_ratio < 0 || range_query_ratio > 1
   || insert_ratio < 0 || insert_ratio > 1
+  || delete_ratio < 0 || update_ratio < 0 || insert_ratio + delete_ratio + update_ratio > 1
+  || recent_delete_ratio < 0 || recent_delete_ratio > 1
   || hotspot_ratio <= 0 || hotspot_ratio > 1) {
     util::fail("workload ratio must be between 0 and 1.");
   }
@@ -520,22 +1222,25 @@ int main(int argc, char* argv[]) {
     case DataType::UINT32: {
       generate<uint32_t>(filename, op_cnt, 
                   range_query_ratio, negative_lookup_ratio, insert_ratio, 
-                  pat, hotspot_ratio,
-                  thread_num, mix, block_num, bulkload_cnt);
+                  delete_ratio, update_ratio, recent_delete_ratio, pat, hotspot_ratio,
+                  lookup_dist, lookup_param,
+                  thread_num, mix, block_num, bulkload_cnt, num_jobs, chunk_size);
       break;
     }
     case DataType::UINT64: {
       generate<uint64_t>(filename, op_cnt, 
                   range_query_ratio, negative_lookup_ratio, insert_ratio, 
-                  pat, hotspot_ratio,
-                  thread_num, mix, block_num, bulkload_cnt);
+                  delete_ratio, update_ratio, recent_delete_ratio, pat, hotspot_ratio,
+                  lookup_dist, lookup_param,
+                  thread_num, mix, block_num, bulkload_cnt, num_jobs, chunk_size);
       break;
     }
     case DataType::STRING: {
       generate<std::string>(filename, op_cnt, 
                   range_query_ratio, 0, insert_ratio, 
-                  pat, hotspot_ratio,
-                  thread_num, mix, block_num, bulkload_cnt);
+                  delete_ratio, update_ratio, recent_delete_ratio, pat, hotspot_ratio,
+                  lookup_dist, lookup_param,
+                  thread_num, mix, block_num, bulkload_cnt, num_jobs, chunk_size);
       break;
     }
   }
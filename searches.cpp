@@ -9,8 +9,46 @@
 # include <random>
 using namespace std;
 
+// Consume search results, so that inlined searches are not optimized away.
+size_t position_sum = 0;
+
+// Check that the inlined accessor path, the std::function path and 
+// std::lower_bound / std::upper_bound return identical positions.
 template<class KeyType, class SearchClass>
-double computeResult(const vector<KeyType>& keys, size_t start_pos, size_t num, size_t error, mt19937_64& generator){
+void verifyResult(const util::DataSpan<KeyType>& keys, size_t start_pos, size_t num, 
+                  const vector<pair<size_t, size_t>>& search_points){
+    typedef typename util::DataSpan<KeyType>::const_iterator Iterator;
+    const std::function<KeyType(Iterator)> at = [](Iterator it)->KeyType{ return *it; };
+    const std::function<bool(const KeyType&, const KeyType&)> less = [](const KeyType& key1, const KeyType& key2)->bool{ 
+        return key1 < key2; 
+    };
+    auto first = keys.begin() + start_pos, last = first + num;
+    for (const auto& point: search_points){
+        const KeyType& lookup_key = keys[start_pos + point.first];
+        auto start = first + point.second;
+        size_t expected = std::lower_bound(first, last, lookup_key) - keys.begin();
+        size_t inlined = SearchClass::lower_bound(first, last, lookup_key, start) - keys.begin();
+        size_t legacy = SearchClass::lower_bound(first, last, lookup_key, start, at, less) - keys.begin();
+        if (inlined != expected || legacy != expected){
+            cerr << SearchClass::name() << "::lower_bound returned wrong result:" << endl;
+            cerr << "Lookup key: " << lookup_key << ", expected: " << expected 
+                 << ", inlined: " << inlined << ", std::function: " << legacy << endl;
+            exit(EXIT_FAILURE);
+        }
+        expected = std::upper_bound(first, last, lookup_key) - keys.begin();
+        inlined = SearchClass::upper_bound(first, last, lookup_key, start) - keys.begin();
+        legacy = SearchClass::upper_bound(first, last, lookup_key, start, at, less) - keys.begin();
+        if (inlined != expected || legacy != expected){
+            cerr << SearchClass::name() << "::upper_bound returned wrong result:" << endl;
+            cerr << "Lookup key: " << lookup_key << ", expected: " << expected 
+                 << ", inlined: " << inlined << ", std::function: " << legacy << endl;
+            exit(EXIT_FAILURE);
+        }
+    }
+}
+
+template<class KeyType, class SearchClass>
+double computeResult(const util::DataSpan<KeyType>& keys, size_t start_pos, size_t num, size_t error, mt19937_64& generator, bool verify){
     const size_t sample_size = std::min(size_t(100000), num);
     uniform_int_distribution<int> coin(0, 1);
     vector<pair<size_t, size_t>> search_points;
@@ -27,16 +65,19 @@ double computeResult(const vector<KeyType>& keys, size_t start_pos, size_t num,
         //     std::cerr << "Actual key: " << keys[accurate] << " at " << accurate << std::endl;
         // }
     }
+    if (verify){
+        verifyResult<KeyType, SearchClass>(keys, start_pos, num, search_points);
+    }
     uint64_t time = util::timing([&](){
         for (unsigned i = 0; i < sample_size; i ++){
-            SearchClass::lower_bound(keys.begin() + start_pos, keys.begin() + start_pos + num, keys[start_pos + search_points[i].first], keys.begin() + start_pos + search_points[i].second) - keys.begin();
+            position_sum += SearchClass::lower_bound(keys.begin() + start_pos, keys.begin() + start_pos + num, keys[start_pos + search_points[i].first], keys.begin() + start_pos + search_points[i].second) - keys.begin();
         }
     });
     return double(time) / sample_size;
 }
 
 template<class KeyType>
-void printResult(const vector<KeyType>& keys, size_t start_pos, size_t num, size_t error, mt19937_64& generator, const string& filename){
+void printResult(const util::DataSpan<KeyType>& keys, size_t start_pos, size_t num, size_t error, mt19937_64& generator, const string& filename, bool verify){
     ofstream fout(filename, std::ofstream::out | std::ofstream::app);
 
     if (!fout.is_open()) {
@@ -45,19 +86,19 @@ void printResult(const vector<KeyType>& keys, size_t start_pos, size_t num, size
     }
 
     fout << num << ',' << error << ',' << "linear," << 
-            computeResult<KeyType, LinearSearch<0>>(keys, start_pos, num, error, generator) << endl;
+            computeResult<KeyType, LinearSearch<0>>(keys, start_pos, num, error, generator, verify) << endl;
     fout << num << ',' << error << ',' << "binary," << 
-            computeResult<KeyType, BranchingBinarySearch<0>>(keys, start_pos, num, error, generator) << endl;
+            computeResult<KeyType, BranchingBinarySearch<0>>(keys, start_pos, num, error, generator, verify) << endl;
     fout << num << ',' << error << ',' << "avx," << 
-            computeResult<KeyType, LinearAVX<KeyType, 0>>(keys, start_pos, num, error, generator) << endl;
+            computeResult<KeyType, LinearAVX<KeyType, 0>>(keys, start_pos, num, error, generator, verify) << endl;
     fout << num << ',' << error << ',' << "exp," << 
-            computeResult<KeyType, ExponentialSearch<0>>(keys, start_pos, num, error, generator) << endl;
+            computeResult<KeyType, ExponentialSearch<0>>(keys, start_pos, num, error, generator, verify) << endl;
     fout << num << ',' << error << ',' << "interp," << 
-            computeResult<KeyType, InterpolationSearch<false>>(keys, start_pos, num, error, generator) << endl;
+            computeResult<KeyType, InterpolationSearch<false>>(keys, start_pos, num, error, generator, verify) << endl;
 }
 
 template<class KeyType>
-void test(const string& filename, size_t start_pos, size_t end_pos, size_t error_bound) {
+void test(const string& filename, size_t start_pos, size_t end_pos, size_t error_bound, bool verify) {
     static constexpr const char* prefix = "data/";
     string dataset_name = filename.data();
     dataset_name.erase(
@@ -69,7 +110,7 @@ void test(const string& filename, size_t start_pos, size_t end_pos, size_t error
                 + to_string(error_bound) + "bd_results_table.csv";
     mt19937_64 generator(42);
     // Load data.
-    vector<KeyType> keys = util::load_data<KeyType>(filename);
+    const util::DataSpan<KeyType> keys = util::map_data<KeyType>(filename);
     if (!is_sorted(keys.begin(), keys.end()))
         util::fail("keys have to be sorted");
 
@@ -81,10 +122,10 @@ void test(const string& filename, size_t start_pos, size_t end_pos, size_t error
     size_t num = 1;
     for (size_t i = 0; i <= floor(log2(end_pos - start_pos)); i ++) {
         size_t error = 0;
-        printResult(keys, start_pos, num, error, generator, result_name);
+        printResult(keys, start_pos, num, error, generator, result_name, verify);
         error = 1;
         for (size_t j = 0; j + 1 < i && error <= error_bound; j ++) {
-            printResult(keys, start_pos, num, error, generator, result_name);
+            printResult(keys, start_pos, num, error, generator, result_name, verify);
             error <<= 1;
         }
         num <<= 1;
@@ -102,7 +143,8 @@ int main(int argc, char* argv[]){
       "e,end-pos", "End position", 
                                cxxopts::value<size_t>()->default_value(to_string(numeric_limits<size_t>::max())))(
       "err-bound", "Error bound", 
-                               cxxopts::value<size_t>()->default_value(to_string(numeric_limits<size_t>::max())));
+                               cxxopts::value<size_t>()->default_value(to_string(numeric_limits<size_t>::max())))(
+      "verify", "Verify that all search paths return identical positions");
 
     options.parse_positional({"data"});
 
@@ -118,15 +160,16 @@ int main(int argc, char* argv[]){
     size_t start_pos = result["start-pos"].as<size_t>();
     size_t end_pos = result["end-pos"].as<size_t>();
     size_t error_bound = result["err-bound"].as<size_t>();
+    const bool verify = result.count("verify");
 
     switch (type) {
         case DataType::UINT32: {
-            test<uint32_t>(filename, start_pos, end_pos, error_bound);
+            test<uint32_t>(filename, start_pos, end_pos, error_bound, verify);
             break;
         }
 
         case DataType::UINT64: {
-            test<uint64_t>(filename, start_pos, end_pos, error_bound);
+            test<uint64_t>(filename, start_pos, end_pos, error_bound, verify);
             break;
         }
     }
@@ -4,16 +4,12 @@
 template<int record>
 class BranchingBinarySearch : public Search<record> {
  public:
-  template<typename Iterator, typename KeyType>
+  template<typename Iterator, typename KeyType, 
+           typename At = KeyAt<KeyType>, typename Less = KeyLess<KeyType>>
   static forceinline Iterator lower_bound(
     Iterator first, Iterator last,
 		const KeyType& lookup_key, Iterator start,
-    std::function<KeyType(Iterator)> at = [](Iterator it)->KeyType{
-      return static_cast<KeyType>(*it);
-    },
-    std::function<bool(const KeyType&, const KeyType&)> less = [](const KeyType& key1, const KeyType& key2)->bool{
-      return key1 < key2;
-    }) {
+    At at = At(), Less less = Less()) {
       record_start();
       Iterator it;
 
@@ -29,16 +25,12 @@ class BranchingBinarySearch : public Search<record> {
       return it;
     }
 
-  template<typename Iterator, typename KeyType>
+  template<typename Iterator, typename KeyType, 
+           typename At = KeyAt<KeyType>, typename Less = KeyLess<KeyType>>
   static forceinline Iterator upper_bound(
     Iterator first, Iterator last,
 		const KeyType& lookup_key, Iterator start,
-    std::function<KeyType(Iterator)> at = [](Iterator it)->KeyType{
-      return static_cast<KeyType>(*it);
-    },
-    std::function<bool(const KeyType&, const KeyType&)> less = [](const KeyType& key1, const KeyType& key2)->bool{
-      return key1 < key2;
-    }) {
+    At at = At(), Less less = Less()) {
       record_start();
       Iterator it;
       
@@ -57,16 +49,12 @@ class BranchingBinarySearch : public Search<record> {
   static std::string name() { return "BinarySearch"; }
 
  private:
-  template<typename Iterator, typename KeyType>
+  template<typename Iterator, typename KeyType, 
+           typename At = KeyAt<KeyType>, typename Less = KeyLess<KeyType>>
   static forceinline Iterator lower_bound_(
     Iterator first, Iterator last,
 		const KeyType& lookup_key, 
-    std::function<KeyType(Iterator)> at = [](Iterator it)->KeyType{
-      return static_cast<KeyType>(*it);
-    },
-    std::function<bool(const KeyType&, const KeyType&)> less = [](const KeyType& key1, const KeyType& key2)->bool{
-      return key1 < key2;
-    }) {
+    At at = At(), Less less = Less()) {
       size_t __len = std::distance(first, last);
 
       while (__len > 0){
@@ -85,16 +73,12 @@ class BranchingBinarySearch : public Search<record> {
       return first;
     }
 
-  template<typename Iterator, typename KeyType>
+  template<typename Iterator, typename KeyType, 
+           typename At = KeyAt<KeyType>, typename Less = KeyLess<KeyType>>
   static forceinline Iterator upper_bound_(
     Iterator first, Iterator last,
 		const KeyType& lookup_key,
-    std::function<KeyType(Iterator)> at = [](Iterator it)->KeyType{
-      return static_cast<KeyType>(*it);
-    },
-    std::function<bool(const KeyType&, const KeyType&)> less = [](const KeyType& key1, const KeyType& key2)->bool{
-      return key1 < key2;
-    }) {
+    At at = At(), Less less = Less()) {
       size_t __len = std::distance(first, last);
 
       while (__len > 0){
@@ -1,19 +1,16 @@
 #pragma once
 #include "search.h"
+#include "branching_binary_search.h"
 
 template<int record>
 class ExponentialSearch : public Search<record> {
  public:
-  template<typename Iterator, typename KeyType>
+  template<typename Iterator, typename KeyType, 
+           typename At = KeyAt<KeyType>, typename Less = KeyLess<KeyType>>
   static forceinline Iterator lower_bound(
     Iterator first, Iterator last,
 		const KeyType& lookup_key, Iterator start,
-    std::function<KeyType(Iterator)> at = [](Iterator it)->KeyType{
-      return static_cast<KeyType>(*it);
-    },
-    std::function<bool(const KeyType&, const KeyType&)> less = [](const KeyType& key1, const KeyType& key2)->bool{
-      return key1 < key2;
-    }) {
+    At at = At(), Less less = Less()) {
       record_start();
       if (first == last) { 
         record_end(first, first);
@@ -49,22 +46,18 @@ class ExponentialSearch : public Search<record> {
           ++l;
         }
       }
-      auto it = BranchingBinarySearch<0>::lower_bound(l, r, lookup_key, l, at);
+      auto it = BranchingBinarySearch<0>::lower_bound(l, r, lookup_key, l, at, less);
 
       record_end(start, it);
       return it;
     }
 
-  template<typename Iterator, typename KeyType>
+  template<typename Iterator, typename KeyType, 
+           typename At = KeyAt<KeyType>, typename Less = KeyLess<KeyType>>
   static forceinline Iterator upper_bound(
     Iterator first, Iterator last,
 		const KeyType& lookup_key, Iterator start,
-    std::function<KeyType(Iterator)> at = [](Iterator it)->KeyType{
-      return static_cast<KeyType>(*it);
-    },
-    std::function<bool(const KeyType&, const KeyType&)> less = [](const KeyType& key1, const KeyType& key2)->bool{
-      return key1 < key2;
-    }) {
+    At at = At(), Less less = Less()) {
       record_start();
       if (first == last) { 
         record_end(first, first);
@@ -100,7 +93,7 @@ class ExponentialSearch : public Search<record> {
         }
         ++l;
       }
-      auto it = BranchingBinarySearch<0>::upper_bound(l, r, lookup_key, l, at);
+      auto it = BranchingBinarySearch<0>::upper_bound(l, r, lookup_key, l, at, less);
 
       record_end(start, it);
       return it;
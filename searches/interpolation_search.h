@@ -5,16 +5,12 @@
 template <int record>
 class InterpolationSearch : public Search<record> {
  public:
-  template<typename Iterator, typename KeyType>
+  template<typename Iterator, typename KeyType, 
+           typename At = KeyAt<KeyType>, typename Less = KeyLess<KeyType>>
   static forceinline Iterator lower_bound(
     Iterator first, Iterator last,
 		const KeyType& lookup_key, Iterator start,
-    std::function<KeyType(Iterator)> at = [](Iterator it)->KeyType{
-      return static_cast<KeyType>(*it);
-    },
-    std::function<bool(const KeyType&, const KeyType&)> less = [](const KeyType& key1, const KeyType& key2)->bool{
-      return key1 < key2;
-    }) {
+    At at = At(), Less less = Less()) {
       record_start();
       Iterator it;
       
@@ -30,16 +26,12 @@ class InterpolationSearch : public Search<record> {
       return it;
     }
 
-  template<typename Iterator, typename KeyType>
+  template<typename Iterator, typename KeyType, 
+           typename At = KeyAt<KeyType>, typename Less = KeyLess<KeyType>>
   static forceinline Iterator upper_bound(
     Iterator first, Iterator last,
 		const KeyType& lookup_key, Iterator start, 
-    std::function<KeyType(Iterator)> at = [](Iterator it)->KeyType{
-      return static_cast<KeyType>(*it);
-    },
-    std::function<bool(const KeyType&, const KeyType&)> less = [](const KeyType& key1, const KeyType& key2)->bool{
-      return key1 < key2;
-    }) {
+    At at = At(), Less less = Less()) {
       record_start();
       Iterator it;
 
@@ -58,10 +50,10 @@ class InterpolationSearch : public Search<record> {
   static std::string name() { return "InterpolationSearch"; }
 
 private:
-  template<typename Iterator, typename KeyType>
+  template<typename Iterator, typename KeyType, typename At>
   static forceinline Iterator lower_bound_(
     Iterator first, Iterator last,
-		const KeyType& lookup_key, std::function<KeyType(Iterator)> at) {
+		const KeyType& lookup_key, At at) {
       if (first == last) {
         return first;
       }
@@ -98,10 +90,10 @@ private:
       return last;
     }
 
-  template<typename Iterator, typename KeyType>
+  template<typename Iterator, typename KeyType, typename At>
   static forceinline Iterator upper_bound_(
     Iterator first, Iterator last,
-		const KeyType& lookup_key, std::function<KeyType(Iterator)> at) {
+		const KeyType& lookup_key, At at) {
       if (first == last) {
         return first;
       }
@@ -4,16 +4,12 @@
 template<int record>
 class LinearSearch: public Search<record> {
  public:
-  template<typename Iterator, typename KeyType>
+  template<typename Iterator, typename KeyType, 
+           typename At = KeyAt<KeyType>, typename Less = KeyLess<KeyType>>
   static forceinline Iterator lower_bound(
     Iterator first, Iterator last,
 		const KeyType& lookup_key, Iterator start,
-    std::function<KeyType(Iterator)> at = [](Iterator it)->KeyType{
-      return static_cast<KeyType>(*it);
-    },
-    std::function<bool(const KeyType&, const KeyType&)> less = [](const KeyType& key1, const KeyType& key2)->bool{
-      return key1 < key2;
-    }) {
+    At at = At(), Less less = Less()) {
       record_start();
       if (first == last) {
         record_end(first, first);
@@ -43,16 +39,12 @@ class LinearSearch: public Search<record> {
       return it;
     }
 
-  template<typename Iterator, typename KeyType>
+  template<typename Iterator, typename KeyType, 
+           typename At = KeyAt<KeyType>, typename Less = KeyLess<KeyType>>
   static forceinline Iterator upper_bound(
     Iterator first, Iterator last,
 		const KeyType& lookup_key, Iterator start, 
-    std::function<KeyType(Iterator)> at = [](Iterator it)->KeyType{
-      return static_cast<KeyType>(*it);
-    },
-    std::function<bool(const KeyType&, const KeyType&)> less = [](const KeyType& key1, const KeyType& key2)->bool{
-      return key1 < key2;
-    }) {
+    At at = At(), Less less = Less()) {
       record_start();
       if (first == last) {
         record_end(first, first);
@@ -4,13 +4,11 @@
 
 #define SHUF(i0, i1, i2, i3) ((i0) + (i1) * 4 + (i2) * 16 + (i3) * 64)
 
-template<typename Iterator, bool direction>
-Iterator static forceinline scan_avx(std::function<Iterator(Iterator, Iterator, const uint32_t&, 
-                            Iterator, std::function<uint32_t(Iterator)>, std::function<bool(const uint32_t&, const uint32_t&)>)> func_search,
-                  std::function<__m256i(__m256i, __m256i)> func_cmp, 
-                  Iterator move_it, Iterator end, const uint32_t& lookup_key,
-                  std::function<uint32_t(Iterator)> at,
-                  std::function<bool(const uint32_t&, const uint32_t&)> less){
+// is_lower: whether fall back to LinearSearch::lower_bound or upper_bound
+template<typename Iterator, bool direction, bool is_lower, __m256i (*func_cmp)(__m256i, __m256i), 
+         typename At, typename Less>
+Iterator static forceinline scan_avx(Iterator move_it, Iterator end, const uint32_t& lookup_key,
+                  At at, Less less){
   size_t n, i = 32;
   if constexpr (direction){
     n = std::distance(move_it, end);
@@ -74,20 +72,28 @@ Iterator static forceinline scan_avx(std::function<Iterator(Iterator, Iterator,
   }
 
   if constexpr (direction){
-    return func_search(move_it, end, lookup_key, move_it, at, less);
+    if constexpr (is_lower){
+      return LinearSearch<0>::lower_bound(move_it, end, lookup_key, move_it, at, less);
+    }
+    else{
+      return LinearSearch<0>::upper_bound(move_it, end, lookup_key, move_it, at, less);
+    }
   }
   else{
-    return func_search(end, move_it, lookup_key, move_it, at, less);
+    if constexpr (is_lower){
+      return LinearSearch<0>::lower_bound(end, move_it, lookup_key, move_it, at, less);
+    }
+    else{
+      return LinearSearch<0>::upper_bound(end, move_it, lookup_key, move_it, at, less);
+    }
   }
 }
 
-template<typename Iterator, bool direction>
-Iterator static forceinline scan_avx(std::function<Iterator(Iterator, Iterator, const uint64_t&, 
-                            Iterator, std::function<uint64_t(Iterator)>, std::function<bool(const uint64_t&, const uint64_t&)>)> func_search,
-                  std::function<__m256i(__m256i, __m256i)> func_cmp, 
-                  Iterator move_it, Iterator end, const uint64_t& lookup_key,
-                  std::function<uint64_t(Iterator)> at,
-                  std::function<bool(const uint64_t&, const uint64_t&)> less){
+// is_lower: whether fall back to LinearSearch::lower_bound or upper_bound
+template<typename Iterator, bool direction, bool is_lower, __m256i (*func_cmp)(__m256i, __m256i), 
+         typename At, typename Less>
+Iterator static forceinline scan_avx(Iterator move_it, Iterator end, const uint64_t& lookup_key,
+                  At at, Less less){
   size_t n, i = 16;
   if constexpr (direction){
     n = std::distance(move_it, end);
@@ -151,29 +157,45 @@ Iterator static forceinline scan_avx(std::function<Iterator(Iterator, Iterator,
   }
 
   if constexpr (direction){
-    return func_search(move_it, end, lookup_key, move_it, at, less);
+    if constexpr (is_lower){
+      return LinearSearch<0>::lower_bound(move_it, end, lookup_key, move_it, at, less);
+    }
+    else{
+      return LinearSearch<0>::upper_bound(move_it, end, lookup_key, move_it, at, less);
+    }
   }
   else{
-    return func_search(end, move_it, lookup_key, move_it, at, less);
+    if constexpr (is_lower){
+      return LinearSearch<0>::lower_bound(end, move_it, lookup_key, move_it, at, less);
+    }
+    else{
+      return LinearSearch<0>::upper_bound(end, move_it, lookup_key, move_it, at, less);
+    }
   }
 }
 
+// Whether Iterator walks a contiguous array of keys read by the default
+// accessor, which is what the vectorized scans load. Other searches, e.g.
+// over the segments of an index, fall back to LinearSearch.
+template<typename Iterator, typename KeyType, typename At>
+constexpr bool is_key_array = std::is_same<At, KeyAt<KeyType>>::value &&
+    std::is_same<typename std::iterator_traits<Iterator>::value_type, KeyType>::value;
+
 template<typename KeyType, int record>
 class LinearAVX: public Search<record>{};
 
 template<int record>
 class LinearAVX<uint32_t, record>: public Search<record> {
  public:
-  template<typename Iterator>
+  template<typename Iterator, 
+           typename At = KeyAt<uint32_t>, typename Less = KeyLess<uint32_t>>
   static forceinline Iterator lower_bound(
     Iterator first, Iterator last,
 		const uint32_t& lookup_key, Iterator start,
-    std::function<uint32_t(Iterator)> at = [](Iterator it)->uint32_t{
-      return static_cast<uint32_t>(*it);
-    },
-    std::function<bool(const uint32_t&, const uint32_t&)> less = [](const uint32_t& key1, const uint32_t& key2)->bool{
-      return key1 < key2;
-    }) {
+    At at = At(), Less less = Less()) {
+      if constexpr (!is_key_array<Iterator, uint32_t, At>) {
+        return LinearSearch<record>::lower_bound(first, last, lookup_key, start, at, less);
+      }
       record_start();
       if (first == last) {
         record_end(first, first);
@@ -184,26 +206,25 @@ class LinearAVX<uint32_t, record>: public Search<record> {
       if (start != last && at(start) < lookup_key){
         Iterator mid = start;
         ++mid;
-        it = scan_avx<Iterator, true>(LinearSearch<0>::lower_bound<Iterator, uint32_t>, _mm256_cmplt_epu32, mid, last, lookup_key, at, less);
+        it = scan_avx<Iterator, true, true, _mm256_cmplt_epu32>(mid, last, lookup_key, at, less);
       }
       else{
-        it = scan_avx<Iterator, false>(LinearSearch<0>::lower_bound<Iterator, uint32_t>, _mm256_cmpge_epu32, start, first, lookup_key, at, less);
+        it = scan_avx<Iterator, false, true, _mm256_cmpge_epu32>(start, first, lookup_key, at, less);
       }
 
       record_end(start, it);
       return it;
     }
 
-  template<typename Iterator>
+  template<typename Iterator, 
+           typename At = KeyAt<uint32_t>, typename Less = KeyLess<uint32_t>>
   static forceinline Iterator upper_bound(
     Iterator first, Iterator last,
 		const uint32_t& lookup_key, Iterator start, 
-    std::function<uint32_t(Iterator)> at = [](Iterator it)->uint32_t{
-      return static_cast<uint32_t>(*it);
-    },
-    std::function<bool(const uint32_t&, const uint32_t&)> less = [](const uint32_t& key1, const uint32_t& key2)->bool{
-      return key1 < key2;
-    }) {
+    At at = At(), Less less = Less()) {
+      if constexpr (!is_key_array<Iterator, uint32_t, At>) {
+        return LinearSearch<record>::upper_bound(first, last, lookup_key, start, at, less);
+      }
       record_start();
       if (first == last) {
         record_end(first, first);
@@ -212,12 +233,12 @@ class LinearAVX<uint32_t, record>: public Search<record> {
 
       Iterator it;
       if (start == last || lookup_key < at(start)){
-        it = scan_avx<Iterator, false>(LinearSearch<0>::upper_bound<Iterator, uint32_t>, _mm256_cmpgt_epu32, start, first, lookup_key, at, less);
+        it = scan_avx<Iterator, false, false, _mm256_cmpgt_epu32>(start, first, lookup_key, at, less);
       }
       else{
         Iterator mid = start;
         ++mid;
-        it = scan_avx<Iterator, true>(LinearSearch<0>::upper_bound<Iterator, uint32_t>, _mm256_cmple_epu32, mid, last, lookup_key, at, less);
+        it = scan_avx<Iterator, true, false, _mm256_cmple_epu32>(mid, last, lookup_key, at, less);
       }
 
       record_end(start, it);
@@ -232,16 +253,15 @@ class LinearAVX<uint32_t, record>: public Search<record> {
 template<int record>
 class LinearAVX<uint64_t, record>: public Search<record> {
  public:
-  template<typename Iterator>
+  template<typename Iterator, 
+           typename At = KeyAt<uint64_t>, typename Less = KeyLess<uint64_t>>
   static forceinline Iterator lower_bound(
     Iterator first, Iterator last,
 		const uint64_t& lookup_key, Iterator start,
-    std::function<uint64_t(Iterator)> at = [](Iterator it)->uint64_t{
-      return static_cast<uint64_t>(*it);
-    },
-    std::function<bool(const uint64_t&, const uint64_t&)> less = [](const uint64_t& key1, const uint64_t& key2)->bool{
-      return key1 < key2;
-    }) {
+    At at = At(), Less less = Less()) {
+      if constexpr (!is_key_array<Iterator, uint64_t, At>) {
+        return LinearSearch<record>::lower_bound(first, last, lookup_key, start, at, less);
+      }
       record_start();
       if (first == last) {
         record_end(first, first);
@@ -252,26 +272,25 @@ class LinearAVX<uint64_t, record>: public Search<record> {
       if (start != last && at(start) < lookup_key){
         Iterator mid = start;
         ++mid;
-        it = scan_avx<Iterator, true>(LinearSearch<0>::lower_bound<Iterator, uint64_t>, _mm256_cmplt_epu64, mid, last, lookup_key, at, less);
+        it = scan_avx<Iterator, true, true, _mm256_cmplt_epu64>(mid, last, lookup_key, at, less);
       }
       else{
-        it = scan_avx<Iterator, false>(LinearSearch<0>::lower_bound<Iterator, uint64_t>, _mm256_cmpge_epu64, start, first, lookup_key, at, less);
+        it = scan_avx<Iterator, false, true, _mm256_cmpge_epu64>(start, first, lookup_key, at, less);
       }
 
       record_end(start, it);
       return it;
     }
 
-  template<typename Iterator>
+  template<typename Iterator, 
+           typename At = KeyAt<uint64_t>, typename Less = KeyLess<uint64_t>>
   static forceinline Iterator upper_bound(
     Iterator first, Iterator last,
 		const uint64_t& lookup_key, Iterator start, 
-    std::function<uint64_t(Iterator)> at = [](Iterator it)->uint64_t{
-      return static_cast<uint64_t>(*it);
-    },
-    std::function<bool(const uint64_t&, const uint64_t&)> less = [](const uint64_t& key1, const uint64_t& key2)->bool{
-      return key1 < key2;
-    }) {
+    At at = At(), Less less = Less()) {
+      if constexpr (!is_key_array<Iterator, uint64_t, At>) {
+        return LinearSearch<record>::upper_bound(first, last, lookup_key, start, at, less);
+      }
       record_start();
       if (first == last) {
         record_end(first, first);
@@ -280,12 +299,12 @@ class LinearAVX<uint64_t, record>: public Search<record> {
 
       Iterator it;
       if (start == last || lookup_key < at(start)){
-        it = scan_avx<Iterator, false>(LinearSearch<0>::upper_bound<Iterator, uint64_t>, _mm256_cmpgt_epu64, start, first, lookup_key, at, less);
+        it = scan_avx<Iterator, false, false, _mm256_cmpgt_epu64>(start, first, lookup_key, at, less);
       }
       else{
         Iterator mid = start;
         ++mid;
-        it = scan_avx<Iterator, true>(LinearSearch<0>::upper_bound<Iterator, uint64_t>, _mm256_cmple_epu64, mid, last, lookup_key, at, less);
+        it = scan_avx<Iterator, true, false, _mm256_cmple_epu64>(mid, last, lookup_key, at, less);
       }
 
       record_end(start, it);
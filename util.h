@@ -15,6 +15,14 @@
 #include <cstring>
 #include <immintrin.h>
 #include <atomic>
+#include <memory>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "utils/latency_histogram.h"
 
 //#define PRINT_ERRORS
 
@@ -63,9 +71,18 @@ struct Operation {
 // Thread information.
 struct alignas(CACHELINE_SIZE) FGParam{
   void *index, *ops, *keys;
-  uint64_t *individual_ns;
+  // Decoder of the thread's operations if the workload is columnar; `ops` is unused then.
+  void *stream;
+  // Latency histogram of the thread, if latencies are measured.
+  util::LatencyHistogram *latencies;
   uint64_t start, limit, op_cnt;
-  uint32_t thread_id;
+  // Maximum number of consecutive lookups issued as one batch.
+  uint64_t batch_size;
+  uint32_t thread_id, num_threads;
+  // Parameters of all threads, so that the first finished thread can stop the others.
+  FGParam *peers;
+  // Set once any thread has finished its operations; each thread polls its own flag.
+  volatile bool stop;
 };
 
 __m256i static forceinline _mm256_cmpge_epu32(__m256i a, __m256i b) {
@@ -108,14 +125,14 @@ namespace util {
 const static uint8_t LOOKUP = 0;
 const static uint8_t RANGE_QUERY = 1;
 const static uint8_t INSERT = 2;
+// Updates carry the new value in `result`.
+const static uint8_t DELETE = 3;
+const static uint8_t UPDATE = 4;
 
 const static uint64_t NOT_FOUND = std::numeric_limits<uint64_t>::max();
 
 const static size_t OVERFLOW = std::numeric_limits<size_t>::max();
 
-static volatile bool running = false;
-static std::atomic<size_t> ready_threads;
-
 static void fail(const std::string& message) {
   std::cerr << message << std::endl;
   exit(EXIT_FAILURE);
@@ -186,6 +203,30 @@ static uint64_t timing(std::function<void()> fn) {
       .count();
 }
 
+// Returns the peak resident set size in bytes of this process, or of any of
+// its terminated children if larger, e.g. when repeats run in forked children.
+static size_t peak_rss() {
+  struct rusage self, children;
+  getrusage(RUSAGE_SELF, &self);
+  getrusage(RUSAGE_CHILDREN, &children);
+  return std::max(self.ru_maxrss, children.ru_maxrss) * size_t(1024);
+}
+
+// Splits [0, n) into `num_threads` contiguous ranges and calls fn(begin, end)
+// on each range from its own thread. The calling thread takes the first range.
+template <typename Fn>
+static void parallel_for(size_t n, size_t num_threads, Fn&& fn) {
+  num_threads = std::max<size_t>(1, std::min(num_threads, n));
+  std::vector<std::thread> workers;
+  for (size_t t = 1; t < num_threads; ++t) {
+    workers.emplace_back([&fn, n, num_threads, t] {
+      fn(n * t / num_threads, n * (t + 1) / num_threads);
+    });
+  }
+  fn(0, n / num_threads);
+  for (auto& worker : workers) worker.join();
+}
+
 // Checks whether data is duplicate free.
 // Note that data has to be sorted.
 template <typename T>
@@ -204,6 +245,120 @@ static bool is_unique(const std::vector<KeyValue<KeyType>>& data) {
   return true;
 }
 
+// Read-only memory mapping of a whole file.
+class MappedFile {
+ public:
+  MappedFile(const std::string& filename, bool populate, bool huge_pages) {
+    const int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+      fail("unable to open " + filename);
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+      close(fd);
+      fail("unable to stat " + filename);
+    }
+    size_ = st.st_size;
+
+    int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+    if (populate) flags |= MAP_POPULATE;
+#endif
+    addr_ = mmap(nullptr, size_, PROT_READ, flags, fd, 0);
+    close(fd);
+    if (addr_ == MAP_FAILED) {
+      fail("unable to map " + filename);
+    }
+#ifdef MADV_HUGEPAGE
+    // Only a hint: file-backed mappings get huge pages only on supporting file systems.
+    if (huge_pages) madvise(addr_, size_, MADV_HUGEPAGE);
+#endif
+  }
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  ~MappedFile() { munmap(addr_, size_); }
+
+  const char* data() const { return static_cast<const char*>(addr_); }
+  size_t size() const { return size_; }
+
+ private:
+  void* addr_;
+  size_t size_;
+};
+
+// Read-only contiguous view of loaded data, which either points into a 
+// memory-mapped file (fixed-width types) or owns a vector (strings).
+// Copies are cheap and share the underlying storage.
+template <typename T>
+class DataSpan {
+ public:
+  typedef T value_type;
+  typedef const T* const_iterator;
+
+  DataSpan() : data_(nullptr), size_(0) {}
+  explicit DataSpan(std::vector<T>&& vec) {
+    auto owner = std::make_shared<const std::vector<T>>(std::move(vec));
+    data_ = owner->data();
+    size_ = owner->size();
+    owner_ = owner;
+  }
+  DataSpan(std::shared_ptr<const MappedFile> file, const T* data, size_t size)
+      : owner_(std::move(file)), data_(data), size_(size) {}
+
+  const T* data() const { return data_; }
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  const T* begin() const { return data_; }
+  const T* end() const { return data_ + size_; }
+  const T& operator[](size_t i) const { return data_[i]; }
+
+ private:
+  // Keeps the mapping or the vector alive.
+  std::shared_ptr<const void> owner_;
+  const T* data_;
+  size_t size_;
+};
+
+template <typename T>
+static bool is_unique(const DataSpan<T>& data) {
+  for (size_t i = 1; i < data.size(); ++i) {
+    if (data[i] == data[i - 1]) return false;
+  }
+  return true;
+}
+
+// Helpers to pass trivially copyable values and vectors of them through a
+// byte buffer, such as a pipe between processes.
+template <typename T>
+static void AppendPod(std::string& out, const T& value) {
+  out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+static T ReadPod(const char*& in) {
+  T value;
+  memcpy(&value, in, sizeof(T));
+  in += sizeof(T);
+  return value;
+}
+
+// Appends the elements of `values` from position `from` on.
+template <typename T>
+static void AppendVector(std::string& out, const std::vector<T>& values, size_t from) {
+  AppendPod(out, static_cast<uint64_t>(values.size() - from));
+  out.append(reinterpret_cast<const char*>(values.data() + from), (values.size() - from) * sizeof(T));
+}
+
+// Appends elements written by AppendVector() to `values`.
+template <typename T>
+static void ReadVector(const char*& in, std::vector<T>& values) {
+  const uint64_t n = ReadPod<uint64_t>(in);
+  const size_t old_size = values.size();
+  values.resize(old_size + n);
+  memcpy(values.data() + old_size, in, n * sizeof(T));
+  in += n * sizeof(T);
+}
+
 // Load from binary file into vector.
 template <typename T>
 static std::vector<T> in_data(std::ifstream& in){
@@ -308,6 +463,91 @@ static std::vector<std::vector<T>> load_data_multithread(const std::string& file
   return data;
 }
 
+// View one size-prefixed array of `file` starting at `offset`, 
+// and advance `offset` past it.
+template <typename T>
+static DataSpan<T> span_data(const std::shared_ptr<const MappedFile>& file, size_t& offset) {
+  uint64_t size;
+  if (offset + sizeof(uint64_t) > file->size()) {
+    fail("mapped file is truncated");
+  }
+  memcpy(&size, file->data() + offset, sizeof(uint64_t));
+  offset += sizeof(uint64_t);
+  if (offset + size * sizeof(T) > file->size()) {
+    fail("mapped file is truncated");
+  }
+  const T* data = reinterpret_cast<const T*>(file->data() + offset);
+  offset += size * sizeof(T);
+  return DataSpan<T>(file, data, size);
+}
+
+// Map binary file without copying. 
+// Types that are not fixed-width fall back to `load_data`.
+// populate: fault in all pages up front (MAP_POPULATE), so that 
+//           operations do not pay for page faults
+// huge_pages: advise transparent huge pages
+template <typename T>
+static DataSpan<T> map_data(const std::string& filename, bool populate = true, 
+                            bool huge_pages = false, bool print = true) {
+  if constexpr (!std::is_trivially_copyable<T>::value) {
+    return DataSpan<T>(load_data<T>(filename, print));
+  }
+  else {
+    DataSpan<T> data;
+    const uint64_t ns = util::timing([&] {
+      auto file = std::make_shared<const MappedFile>(filename, populate, huge_pages);
+      size_t offset = 0;
+      data = span_data<T>(file, offset);
+    });
+    const uint64_t ms = ns / 1e6;
+
+    if (print) {
+      std::cout << "mapped " << data.size() << " values from " << filename << " in "
+                << ms << " ms (" << static_cast<double>(data.size()) / 1000 / ms
+                << " M values/s)" << std::endl;
+    }
+
+    return data;
+  }
+}
+
+template <typename T>
+static std::vector<DataSpan<T>> map_data_multithread(const std::string& filename, bool populate = true, 
+                                                     bool huge_pages = false, bool print = true) {
+  std::vector<DataSpan<T>> data;
+  if constexpr (!std::is_trivially_copyable<T>::value) {
+    for (auto& vec: load_data_multithread<T>(filename, print)) {
+      data.emplace_back(std::move(vec));
+    }
+  }
+  else {
+    size_t size = 0;
+    const uint64_t ns = util::timing([&] {
+      auto file = std::make_shared<const MappedFile>(filename, populate, huge_pages);
+      // Read thread number.
+      uint64_t len;
+      if (file->size() < sizeof(uint64_t)) {
+        fail("mapped file is truncated");
+      }
+      memcpy(&len, file->data(), sizeof(uint64_t));
+      size_t offset = sizeof(uint64_t);
+      data.reserve(len);
+      for (size_t i = 0; i < len; i ++){
+        data.push_back(span_data<T>(file, offset));
+        size += data[i].size();
+      }
+    });
+    const uint64_t ms = ns / 1e6;
+
+    if (print) {
+      std::cout << "mapped " << size << " values from " << filename << " in "
+                << ms << " ms (" << static_cast<double>(size) / 1000 / ms
+                << " M values/s)" << std::endl;
+    }
+  }
+  return data;
+}
+
 // Write from vector into binary file.
 template <typename T>
 static void out_data(const std::vector<T>& data, std::ofstream& out) {
@@ -395,8 +635,8 @@ static void write_data_multithread(std::vector<T> const* data, uint64_t len, con
 }
 
 // Generate deterministic values for keys.
-template <class KeyType>
-static std::vector<KeyValue<KeyType>> add_values(const std::vector<KeyType>& keys) {
+template <class Container, class KeyType = typename Container::value_type>
+static std::vector<KeyValue<KeyType>> add_values(const Container& keys) {
   std::vector<KeyValue<KeyType>> result;
   result.reserve(keys.size());
 
@@ -409,6 +649,17 @@ static std::vector<KeyValue<KeyType>> add_values(const std::vector<KeyType>& key
   return result;
 }
 
+// MurmurHash3's 64-bit finalizer, each bit of the result depending on all
+// bits of x.
+static inline uint64_t mix64(uint64_t x) {
+  x ^= x >> 33;
+  x *= 0xff51afd7ed558ccdull;
+  x ^= x >> 33;
+  x *= 0xc4ceb9fe1a85ec53ull;
+  x ^= x >> 33;
+  return x;
+}
+
 // Based on: https://en.wikipedia.org/wiki/Xorshift
 class FastRandom {
  public:
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <math.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace util {
+
+// Log-bucketed latency histogram in the style of HdrHistogram.
+// Values below 2^(kSubBucketBits + 1) are recorded exactly; larger values
+// fall into buckets whose width is 2^-kSubBucketBits of their magnitude,
+// so every reported percentile is within that relative error.
+// Count, sum, sum of squares and maximum are tracked exactly.
+class LatencyHistogram {
+ public:
+  static constexpr unsigned kSubBucketBits = 7;
+  static constexpr size_t kSubBuckets = size_t(1) << kSubBucketBits;
+  static constexpr size_t kNumBuckets = (64 - kSubBucketBits + 1) * kSubBuckets;
+
+  LatencyHistogram() : counts_(kNumBuckets, 0) {}
+
+  void Record(uint64_t value, uint64_t count = 1) {
+    counts_[BucketOf(value)] += count;
+    count_ += count;
+    sum_ += double(value) * count;
+    square_sum_ += double(value) * value * count;
+    max_ = std::max(max_, value);
+  }
+
+  void Merge(const LatencyHistogram& other) {
+    for (size_t i = 0; i < kNumBuckets; ++i) {
+      counts_[i] += other.counts_[i];
+    }
+    count_ += other.count_;
+    sum_ += other.sum_;
+    square_sum_ += other.square_sum_;
+    max_ = std::max(max_, other.max_);
+  }
+
+  void Reset() {
+    std::fill(counts_.begin(), counts_.end(), 0);
+    count_ = 0;
+    sum_ = square_sum_ = 0;
+    max_ = 0;
+  }
+
+  uint64_t count() const { return count_; }
+  uint64_t max() const { return max_; }
+  double mean() const { return count_ ? sum_ / count_ : 0; }
+  // Sample standard deviation.
+  double stddev() const {
+    return sqrt((square_sum_ - sum_ * sum_ / count_) / (count_ - 1));
+  }
+
+  // Returns the value at the given percentile in [0, 100], i.e. the element
+  // at index count * percentile / 100 of the sorted recorded values.
+  uint64_t Percentile(double percentile) const {
+    if (count_ == 0) return 0;
+    const uint64_t rank =
+        std::min(uint64_t(count_ * percentile / 100), count_ - 1);
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kNumBuckets; ++i) {
+      seen += counts_[i];
+      if (seen > rank) {
+        return std::min(HighestOf(i), max_);
+      }
+    }
+    return max_;
+  }
+
+  // Appends the histogram to `out` in binary, to be read back by
+  // Deserialize() in the same build.
+  void Serialize(std::string& out) const {
+    out.append(reinterpret_cast<const char*>(counts_.data()),
+               kNumBuckets * sizeof(uint64_t));
+    out.append(reinterpret_cast<const char*>(&count_), sizeof(count_));
+    out.append(reinterpret_cast<const char*>(&sum_), sizeof(sum_));
+    out.append(reinterpret_cast<const char*>(&square_sum_), sizeof(square_sum_));
+    out.append(reinterpret_cast<const char*>(&max_), sizeof(max_));
+  }
+
+  // Reads a histogram written by Serialize() at `in`, and advances `in`.
+  void Deserialize(const char*& in) {
+    memcpy(counts_.data(), in, kNumBuckets * sizeof(uint64_t));
+    in += kNumBuckets * sizeof(uint64_t);
+    memcpy(&count_, in, sizeof(count_));
+    in += sizeof(count_);
+    memcpy(&sum_, in, sizeof(sum_));
+    in += sizeof(sum_);
+    memcpy(&square_sum_, in, sizeof(square_sum_));
+    in += sizeof(square_sum_);
+    memcpy(&max_, in, sizeof(max_));
+    in += sizeof(max_);
+  }
+
+  // Writes one "value,count" line per non-empty bucket, where value is the
+  // largest value of the bucket.
+  void WriteCSV(std::ostream& out, const std::string& prefix) const {
+    for (size_t i = 0; i < kNumBuckets; ++i) {
+      if (counts_[i]) {
+        out << prefix << std::min(HighestOf(i), max_) << "," << counts_[i]
+            << "\n";
+      }
+    }
+  }
+
+ private:
+  static size_t BucketOf(uint64_t value) {
+    if (value < kSubBuckets) return value;
+    const unsigned shift = 63 - __builtin_clzll(value) - kSubBucketBits;
+    return shift * kSubBuckets + (value >> shift);
+  }
+
+  static uint64_t HighestOf(size_t bucket) {
+    if (bucket < kSubBuckets) return bucket;
+    const unsigned shift = bucket / kSubBuckets - 1;
+    const uint64_t sub_bucket = bucket - shift * kSubBuckets;
+    return ((sub_bucket + 1) << shift) - 1;
+  }
+
+  std::vector<uint64_t> counts_;
+  uint64_t count_ = 0;
+  double sum_ = 0, square_sum_ = 0;
+  uint64_t max_ = 0;
+};
+
+}  // namespace util
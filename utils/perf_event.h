@@ -22,6 +22,7 @@ WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #if defined(__linux__)
 
+#include <cerrno>
 #include <chrono>
 #include <cstring>
 #include <iomanip>
@@ -68,18 +69,22 @@ struct PerfEvent {
       registerCounter("L1-misses", PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D|(PERF_COUNT_HW_CACHE_OP_READ<<8)|(PERF_COUNT_HW_CACHE_RESULT_MISS<<16));
       registerCounter("LLC-misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
       registerCounter("branch-misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+      registerCounter("dTLB-misses", PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB|(PERF_COUNT_HW_CACHE_OP_READ<<8)|(PERF_COUNT_HW_CACHE_RESULT_MISS<<16));
       registerCounter("task-clock", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK);
       // additional counters can be found in linux/perf_event.h
 
-      for (unsigned i=0; i<events.size(); i++) {
+      // counters that can not be opened (unsupported by the CPU or forbidden
+      // by perf_event_paranoid) are dropped, the others remain usable
+      for (unsigned i=0; i<events.size();) {
          auto& event = events[i];
          event.fd = syscall(__NR_perf_event_open, &event.pe, 0, -1, -1, 0);
          if (event.fd < 0) {
-            std::cerr << "Error opening counter " << names[i] << std::endl;
-            events.resize(0);
-            names.resize(0);
-            return;
+            std::cerr << "Error opening counter " << names[i] << ": " << strerror(errno) << std::endl;
+            events.erase(events.begin() + i);
+            names.erase(names.begin() + i);
+            continue;
          }
+         i++;
       }
    }
 
@@ -250,9 +255,13 @@ struct PerfEventBlock {
 
 #else
 #include <ostream>
+#include <string>
+#include <vector>
 struct PerfEvent {
+  std::vector<int> events;
   void startCounters() {}
   void stopCounters() {}
+  double getCounter(const std::string&) { return -1; }
   void printReport(std::ostream&, uint64_t) {}
   template <class T> void setParam(const std::string&, const T&) {};
 };
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../util.h"
+
+namespace util {
+
+// Projections of a KeyValue, for ProjectionIterator.
+struct KeyOf {
+  template <class KeyType>
+  KeyType operator()(const KeyValue<KeyType>& kv) const { return kv.key; }
+};
+
+struct ValueOf {
+  template <class KeyType>
+  uint64_t operator()(const KeyValue<KeyType>& kv) const { return kv.value; }
+};
+
+// The key converted to To, for indexes wrapping keys in their own type.
+template <class To>
+struct KeyAs {
+  template <class KeyType>
+  To operator()(const KeyValue<KeyType>& kv) const { return To(kv.key); }
+};
+
+struct PairOf {
+  template <class KeyType>
+  std::pair<KeyType, uint64_t> operator()(const KeyValue<KeyType>& kv) const {
+    return std::pair<KeyType, uint64_t>(kv.key, kv.value);
+  }
+};
+
+// Random access iterator over an array of KeyValue, yielding each element
+// through Projection by value. Indexes bulk load through it straight from
+// the dataset instead of first copying it into the layout they take.
+//
+// As elements are produced on the fly, `reference` is not a reference:
+// standard algorithms that only read through the iterator accept it, but
+// it cannot be written through.
+template <class KeyType, class Projection>
+class ProjectionIterator {
+ public:
+  using iterator_category = std::random_access_iterator_tag;
+  using value_type = std::decay_t<decltype(Projection()(std::declval<const KeyValue<KeyType>&>()))>;
+  using difference_type = std::ptrdiff_t;
+  using reference = value_type;
+
+  // Holds the projected element, for operator->.
+  struct pointer {
+    value_type value;
+    const value_type* operator->() const { return &value; }
+  };
+
+  ProjectionIterator() = default;
+  explicit ProjectionIterator(const KeyValue<KeyType>* it) : it_(it) {}
+
+  reference operator*() const { return Projection()(*it_); }
+  pointer operator->() const { return pointer{**this}; }
+  reference operator[](difference_type n) const { return Projection()(it_[n]); }
+
+  ProjectionIterator& operator++() { ++it_; return *this; }
+  ProjectionIterator& operator--() { --it_; return *this; }
+  ProjectionIterator operator++(int) { return ProjectionIterator(it_++); }
+  ProjectionIterator operator--(int) { return ProjectionIterator(it_--); }
+  ProjectionIterator& operator+=(difference_type n) { it_ += n; return *this; }
+  ProjectionIterator& operator-=(difference_type n) { it_ -= n; return *this; }
+  ProjectionIterator operator+(difference_type n) const { return ProjectionIterator(it_ + n); }
+  ProjectionIterator operator-(difference_type n) const { return ProjectionIterator(it_ - n); }
+  friend ProjectionIterator operator+(difference_type n, const ProjectionIterator& it) { return it + n; }
+  difference_type operator-(const ProjectionIterator& other) const { return it_ - other.it_; }
+
+  bool operator==(const ProjectionIterator& other) const { return it_ == other.it_; }
+  bool operator!=(const ProjectionIterator& other) const { return it_ != other.it_; }
+  bool operator<(const ProjectionIterator& other) const { return it_ < other.it_; }
+  bool operator>(const ProjectionIterator& other) const { return it_ > other.it_; }
+  bool operator<=(const ProjectionIterator& other) const { return it_ <= other.it_; }
+  bool operator>=(const ProjectionIterator& other) const { return it_ >= other.it_; }
+
+  // The KeyValue the iterator is at.
+  const KeyValue<KeyType>* base() const { return it_; }
+
+ private:
+  const KeyValue<KeyType>* it_ = nullptr;
+};
+
+// View of a dataset through a projection, e.g. `Projected<KeyType, KeyOf>`
+// for its keys. It does not own the dataset, which must outlive it.
+template <class KeyType, class Projection>
+class Projected {
+ public:
+  using iterator = ProjectionIterator<KeyType, Projection>;
+  using value_type = typename iterator::value_type;
+
+  explicit Projected(const std::vector<KeyValue<KeyType>>& data)
+      : data_(data.data()), size_(data.size()) {}
+
+  iterator begin() const { return iterator(data_); }
+  iterator end() const { return iterator(data_ + size_); }
+  size_t size() const { return size_; }
+  value_type operator[](size_t i) const { return Projection()(data_[i]); }
+
+ private:
+  const KeyValue<KeyType>* data_;
+  size_t size_;
+};
+
+template <class KeyType>
+Projected<KeyType, KeyOf> keys_of(const std::vector<KeyValue<KeyType>>& data) {
+  return Projected<KeyType, KeyOf>(data);
+}
+
+template <class KeyType>
+Projected<KeyType, ValueOf> values_of(const std::vector<KeyValue<KeyType>>& data) {
+  return Projected<KeyType, ValueOf>(data);
+}
+
+template <class KeyType>
+Projected<KeyType, PairOf> pairs_of(const std::vector<KeyValue<KeyType>>& data) {
+  return Projected<KeyType, PairOf>(data);
+}
+
+// Byte `depth` of the binary-comparable form of `key` that convert2String
+// produces, without materializing it: big-endian integers, and strings
+// terminated by a zero byte.
+template <class KeyType>
+inline uint8_t key_byte(const KeyType& key, size_t depth) {
+  if constexpr (std::is_same<KeyType, std::string>::value){
+    return depth < key.size() ? static_cast<uint8_t>(key[depth]) : 0;
+  }
+  else{
+    static_assert(std::is_integral<KeyType>::value, "Undefined key type.");
+    return static_cast<uint8_t>(key >> (8 * (sizeof(KeyType) - 1 - depth)));
+  }
+}
+
+}  // namespace util
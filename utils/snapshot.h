@@ -0,0 +1,174 @@
+#pragma once
+
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../util.h"
+
+namespace util {
+
+// Index snapshot format, for indexes made of flat arrays.
+//
+// The file starts with a SnapshotHeader, followed by sections, each one
+// array: a uint64 element count at a multiple of kSnapshotAlignment bytes,
+// and the elements at the next multiple. Sections are aligned so that a
+// loaded index can use them in place from a read-only mapping, which every
+// process reloading the snapshot shares through the page cache.
+struct SnapshotHeader {
+  char magic[8];
+  uint32_t version;
+  // sizeof(KeyType).
+  uint32_t key_size;
+  uint64_t num_sections;
+  uint64_t reserved;
+};
+static_assert(sizeof(SnapshotHeader) == 32, "SnapshotHeader must not be padded");
+
+static constexpr char kSnapshotMagic[8] = {'T', 'L', 'I', 'S', 'N', 'A', 'P', '\0'};
+static constexpr uint32_t kSnapshotVersion = 1;
+static constexpr size_t kSnapshotAlignment = 64;
+
+// Collects the sections of a snapshot and writes them out.
+class SnapshotWriter {
+ public:
+  explicit SnapshotWriter(size_t key_size) : key_size_(key_size) {}
+
+  template <typename T>
+  void Add(const T* data, size_t n) {
+    static_assert(std::is_trivially_copyable<T>::value, "Snapshot sections must be trivially copyable");
+    sections_.emplace_back(reinterpret_cast<const char*>(data), n, sizeof(T));
+  }
+
+  template <typename T>
+  void AddValue(const T& value) {
+    Add(&value, 1);
+  }
+
+  // Writes the snapshot to a temporary file renamed to `filename`, so that
+  // concurrent readers never see a partial snapshot. Returns false on failure.
+  bool Write(const std::string& filename) const {
+    const std::string tmp_filename = filename + ".tmp" + std::to_string(getpid());
+    std::ofstream out(tmp_filename, std::ios::binary);
+    if (!out.is_open()){
+      return false;
+    }
+
+    SnapshotHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, kSnapshotMagic, sizeof(kSnapshotMagic));
+    header.version = kSnapshotVersion;
+    header.key_size = key_size_;
+    header.num_sections = sections_.size();
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    size_t offset = sizeof(header);
+    const char zeros[kSnapshotAlignment] = {0};
+    auto pad = [&] {
+      const size_t padding = (kSnapshotAlignment - offset % kSnapshotAlignment) % kSnapshotAlignment;
+      out.write(zeros, padding);
+      offset += padding;
+    };
+    for (const auto& section: sections_){
+      pad();
+      const uint64_t count = section.count;
+      out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+      offset += sizeof(count);
+      pad();
+      out.write(section.data, section.count * section.element_size);
+      offset += section.count * section.element_size;
+    }
+    out.close();
+    if (!out || rename(tmp_filename.c_str(), filename.c_str()) != 0){
+      remove(tmp_filename.c_str());
+      return false;
+    }
+    return true;
+  }
+
+ private:
+  struct Section {
+    Section(const char* data, size_t count, size_t element_size)
+        : data(data), count(count), element_size(element_size) {}
+    const char* data;
+    size_t count;
+    size_t element_size;
+  };
+
+  const size_t key_size_;
+  // Point into the index, which must outlive the writer.
+  std::vector<Section> sections_;
+};
+
+// Maps a snapshot and hands out its sections in order.
+class SnapshotReader {
+ public:
+  // Maps `filename` if it is a snapshot of this version for keys of
+  // `key_size` bytes. Returns false, mapping nothing, otherwise.
+  bool Open(const std::string& filename, size_t key_size) {
+    SnapshotHeader header;
+    {
+      std::ifstream in(filename, std::ios::binary);
+      if (!in.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+          memcmp(header.magic, kSnapshotMagic, sizeof(kSnapshotMagic)) != 0 ||
+          header.version != kSnapshotVersion || header.key_size != key_size){
+        return false;
+      }
+    }
+    file_ = std::make_shared<const MappedFile>(filename, true, false);
+    offset_ = sizeof(header);
+    remaining_ = header.num_sections;
+    return true;
+  }
+
+  // Views the next section in place.
+  template <typename T>
+  DataSpan<T> Next() {
+    if (remaining_ == 0){
+      fail("snapshot has fewer sections than expected");
+    }
+    --remaining_;
+    uint64_t count;
+    offset_ = Align(offset_);
+    if (offset_ + sizeof(count) > file_->size()){
+      fail("snapshot is truncated");
+    }
+    memcpy(&count, file_->data() + offset_, sizeof(count));
+    offset_ = Align(offset_ + sizeof(count));
+    if (offset_ + count * sizeof(T) > file_->size()){
+      fail("snapshot is truncated");
+    }
+    const T* data = reinterpret_cast<const T*>(file_->data() + offset_);
+    offset_ += count * sizeof(T);
+    return DataSpan<T>(file_, data, count);
+  }
+
+  template <typename T>
+  T NextValue() {
+    DataSpan<T> span = Next<T>();
+    if (span.size() != 1){
+      fail("snapshot section is not a single value");
+    }
+    return span[0];
+  }
+
+  // The mapping, to keep sections in use alive.
+  std::shared_ptr<const MappedFile> file() const { return file_; }
+
+ private:
+  static size_t Align(size_t offset) {
+    return (offset + kSnapshotAlignment - 1) / kSnapshotAlignment * kSnapshotAlignment;
+  }
+
+  std::shared_ptr<const MappedFile> file_;
+  size_t offset_ = 0;
+  uint64_t remaining_ = 0;
+};
+
+}  // namespace util
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <dtl/thread.hpp>
+
+#include "../util.h"
+
+namespace util {
+
+// Persistent pool of pinned worker threads, owned by the harness.
+// Worker i is pinned to the i-th core of the process' CPU affinity mask.
+// Every call to Run() wakes all workers, releases them together through a
+// start barrier, and waits until all of them have returned from the task.
+class ThreadPool {
+ public:
+  explicit ThreadPool(size_t num_threads) : num_threads_(num_threads) {
+    std::vector<uint32_t> cores;
+    const auto mask = dtl::this_thread::get_cpu_affinity();
+    for (auto it = mask.on_bits_begin(); it != mask.on_bits_end(); it++) {
+      cores.push_back(*it);
+    }
+    if (cores.empty()) {
+      cores.push_back(0);
+    }
+    workers_.reserve(num_threads_);
+    for (size_t i = 0; i < num_threads_; ++i) {
+      workers_.push_back(dtl::thread(cores[i % cores.size()],
+                                     [this, i]() { WorkerLoop(i); }));
+    }
+  }
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      shutdown_ = true;
+    }
+    wake_cv_.notify_all();
+    for (auto& worker : workers_) {
+      worker.join();
+    }
+  }
+
+  size_t size() const { return num_threads_; }
+
+  // Runs task(thread_id) on every worker.
+  // Returns the nanoseconds from the release of the start barrier until
+  // the first call to Finish(), or until the last worker returned if no
+  // worker called Finish().
+  uint64_t Run(std::function<void(uint32_t)> task) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      task_ = std::move(task);
+      ready_ = 0;
+      done_ = 0;
+      finished_ = false;
+      ++round_;
+    }
+    wake_cv_.notify_all();
+
+    // Start barrier: wait until every worker is spinning on `go_`.
+    while (ready_.load(std::memory_order_acquire) < num_threads_)
+      ;
+    start_ = std::chrono::high_resolution_clock::now();
+    go_.store(round_, std::memory_order_release);
+
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      done_cv_.wait(lock, [this]() { return done_ == num_threads_; });
+    }
+    Finish();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(end_ - start_)
+        .count();
+  }
+
+  // Marks the end of the timed section; only the first call counts.
+  void Finish() {
+    if (!finished_.exchange(true)) {
+      end_ = std::chrono::high_resolution_clock::now();
+    }
+  }
+
+ private:
+  void WorkerLoop(uint32_t thread_id) {
+    uint64_t seen = 0;
+    while (true) {
+      std::function<void(uint32_t)>* task;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        wake_cv_.wait(lock, [&]() { return shutdown_ || round_ != seen; });
+        if (shutdown_) return;
+        seen = round_;
+        task = &task_;
+      }
+
+      ready_.fetch_add(1, std::memory_order_acq_rel);
+      while (go_.load(std::memory_order_acquire) != seen)
+        ;
+
+      (*task)(thread_id);
+
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++done_;
+      }
+      done_cv_.notify_one();
+    }
+  }
+
+  const size_t num_threads_;
+  std::vector<std::thread> workers_;
+
+  std::mutex mutex_;
+  std::condition_variable wake_cv_, done_cv_;
+  std::function<void(uint32_t)> task_;
+  uint64_t round_ = 0;
+  size_t done_ = 0;
+  bool shutdown_ = false;
+
+  alignas(CACHELINE_SIZE) std::atomic<size_t> ready_{0};
+  alignas(CACHELINE_SIZE) std::atomic<uint64_t> go_{0};
+  alignas(CACHELINE_SIZE) std::atomic<bool> finished_{false};
+  std::chrono::high_resolution_clock::time_point start_, end_;
+};
+
+}  // namespace util
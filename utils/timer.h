@@ -0,0 +1,137 @@
+#pragma once
+
+#include <x86intrin.h>
+
+#include <algorithm>
+#include <boost/chrono.hpp>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <type_traits>
+#include <vector>
+
+#include "../util.h"
+
+namespace util {
+
+// Timer policies used to time single operations and searches.
+// Now() returns a raw tick count; ElapsedNs() converts the difference of two
+// ticks to nanoseconds after subtracting the calibrated cost of Now() itself.
+// Calibrate() must be called once before measuring.
+template <class Clock>
+class TimerBase {
+ public:
+  static forceinline uint64_t ElapsedNs(uint64_t start, uint64_t end) {
+    const uint64_t ticks = end - start;
+    return ticks > overhead_ ? (ticks - overhead_) * ns_per_tick_ : 0;
+  }
+
+  static void Calibrate() {
+    ns_per_tick_ = Clock::MeasureNsPerTick();
+
+    // Overhead of an empty measurement: median of back-to-back reads.
+    std::vector<uint64_t> samples(1001);
+    for (auto& sample : samples) {
+      const uint64_t start = Clock::Now();
+      sample = Clock::Now() - start;
+    }
+    std::nth_element(samples.begin(), samples.begin() + samples.size() / 2,
+                     samples.end());
+    overhead_ = samples[samples.size() / 2];
+  }
+
+  static double OverheadNs() { return overhead_ * ns_per_tick_; }
+  static double NsPerTick() { return ns_per_tick_; }
+
+ private:
+  static inline double ns_per_tick_ = 1;
+  static inline uint64_t overhead_ = 0;
+};
+
+// Wall clock through std::chrono.
+struct ChronoTimer : TimerBase<ChronoTimer> {
+  static const char* name() { return "chrono"; }
+  static forceinline uint64_t Now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::high_resolution_clock::now().time_since_epoch())
+        .count();
+  }
+  static double MeasureNsPerTick() { return 1; }
+};
+
+// CPU time of the calling thread.
+struct ThreadClockTimer : TimerBase<ThreadClockTimer> {
+  static const char* name() { return "thread_clock"; }
+  static forceinline uint64_t Now() {
+    return boost::chrono::duration_cast<boost::chrono::nanoseconds>(
+               boost::chrono::thread_clock::now().time_since_epoch())
+        .count();
+  }
+  static double MeasureNsPerTick() { return 1; }
+};
+
+// Frequency of the time stamp counter, measured against the wall clock.
+// Assumes an invariant TSC, which all recent x86 CPUs have.
+static double MeasureTscNsPerTick() {
+  const auto wall_start = std::chrono::steady_clock::now();
+  const uint64_t tsc_start = __rdtsc();
+  while (std::chrono::steady_clock::now() - wall_start <
+         std::chrono::milliseconds(50))
+    ;
+  const uint64_t tsc_end = __rdtsc();
+  const auto wall_end = std::chrono::steady_clock::now();
+  return double(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    wall_end - wall_start)
+                    .count()) /
+         (tsc_end - tsc_start);
+}
+
+// rdtscp, which waits for all previous instructions to finish.
+struct TscTimer : TimerBase<TscTimer> {
+  static const char* name() { return "tsc"; }
+  static forceinline uint64_t Now() {
+    unsigned int aux;
+    return __rdtscp(&aux);
+  }
+  static double MeasureNsPerTick() { return MeasureTscNsPerTick(); }
+};
+
+// rdtsc between load fences, so that no instruction moves across the read.
+struct FencedTscTimer : TimerBase<FencedTscTimer> {
+  static const char* name() { return "tsc_fenced"; }
+  static forceinline uint64_t Now() {
+    _mm_lfence();
+    const uint64_t tsc = __rdtsc();
+    _mm_lfence();
+    return tsc;
+  }
+  static double MeasureNsPerTick() { return MeasureTscNsPerTick(); }
+};
+
+// Timer selected at compile time through TLI_TIMER_TSC or
+// TLI_TIMER_TSC_FENCED. Timer times single-threaded runs, ThreadTimer
+// multithreaded ones; the TSC timers serve both since threads are pinned.
+#if defined(TLI_TIMER_TSC_FENCED)
+using Timer = FencedTscTimer;
+using ThreadTimer = FencedTscTimer;
+#elif defined(TLI_TIMER_TSC)
+using Timer = TscTimer;
+using ThreadTimer = TscTimer;
+#else
+using Timer = ChronoTimer;
+using ThreadTimer = ThreadClockTimer;
+#endif
+
+static void CalibrateTimers() {
+  Timer::Calibrate();
+  ThreadTimer::Calibrate();
+  std::cout << "Timer: " << Timer::name() << ", " << Timer::NsPerTick()
+            << " ns/tick, overhead " << Timer::OverheadNs() << " ns";
+  if (!std::is_same<Timer, ThreadTimer>::value) {
+    std::cout << " (" << ThreadTimer::name() << " overhead "
+              << ThreadTimer::OverheadNs() << " ns)";
+  }
+  std::cout << std::endl;
+}
+
+}  // namespace util
@@ -0,0 +1,525 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../util.h"
+
+namespace util {
+
+// Compressed columnar workload format, for fixed-width keys.
+//
+// The file starts with a WorkloadHeader, followed by one section per thread:
+//   uint64 operation count, uint64 chunk count,
+//   (chunk count + 1) uint64 chunk offsets relative to the end of the table,
+//   the chunks.
+// A chunk holds up to `chunk_size` operations, stored column by column:
+//   uint32 operation count, uint32 run count,
+//   op code of every run (uint8), length of every run (uint32),
+//   lo keys of all operations,
+//   hi keys of range queries, as hi_key - lo_key,
+//   results of lookups, as result + 1, so that NOT_FOUND and positive
+//   lookups pack into a single bit,
+//   results of the other operations: range query sums, and the values
+//   of inserts and updates.
+// hi keys of other operations are not stored and read back as 0.
+// Every integer column is bit-packed against a frame of reference: a mode
+// byte, a bit width byte, a uint64 base and the packed words. Non-decreasing
+// columns, such as sorted runs of inserts, are delta-encoded instead when
+// that is narrower. Chunks are padded to multiples of 8 bytes, and the file
+// ends with 8 zero bytes so that columns can be read with unaligned 8-byte loads.
+struct WorkloadHeader {
+  char magic[8];
+  uint32_t version;
+  // sizeof(KeyType).
+  uint32_t key_size;
+  uint64_t num_threads;
+  uint64_t num_blocks;
+  uint64_t chunk_size;
+  uint64_t op_count;
+  // size_t(-1) if the whole dataset minus the inserts is bulk loaded.
+  uint64_t bulkload_count;
+  double range_query_ratio;
+  double negative_lookup_ratio;
+  double insert_ratio;
+  double hotspot_ratio;
+  uint32_t insert_pattern;
+  uint32_t mix;
+  double delete_ratio;
+  double update_ratio;
+  // Share of the deletes removing the thread's latest insert.
+  double recent_delete_ratio;
+  // Distribution of the lookup keys as numbered by generate, and its parameter.
+  uint64_t lookup_distribution;
+  double lookup_param;
+};
+static_assert(sizeof(WorkloadHeader) == 136, "WorkloadHeader must not be padded");
+
+static constexpr char kWorkloadMagic[8] = {'T', 'L', 'I', 'W', 'K', 'L', 'D', '\0'};
+static constexpr uint32_t kWorkloadVersion = 3;
+static constexpr size_t kDefaultChunkSize = 4096;
+
+// Whether `filename` is a columnar workload rather than a size-prefixed array.
+[[maybe_unused]] static bool is_columnar_workload(const std::string& filename) {
+  std::ifstream in(filename, std::ios::binary);
+  char magic[sizeof(kWorkloadMagic)];
+  return in.read(magic, sizeof(magic)) && memcmp(magic, kWorkloadMagic, sizeof(magic)) == 0;
+}
+
+// Appends `values` to `out` as one bit-packed column.
+[[maybe_unused]] static void pack_column(const std::vector<uint64_t>& values, std::vector<char>& out) {
+  enum : uint8_t { FOR = 0, DELTA = 1 };
+  auto width_of = [](uint64_t x) -> uint8_t { return x ? 64 - __builtin_clzll(x) : 0; };
+
+  uint8_t mode = FOR, width = 0;
+  uint64_t base = 0;
+  if (!values.empty()){
+    const auto minmax = std::minmax_element(values.begin(), values.end());
+    base = *minmax.first;
+    width = width_of(*minmax.second - base);
+    if (std::is_sorted(values.begin(), values.end())){
+      uint64_t max_delta = 0;
+      for (size_t i = 1; i < values.size(); ++i){
+        max_delta = std::max(max_delta, values[i] - values[i - 1]);
+      }
+      if (width_of(max_delta) < width){
+        mode = DELTA;
+        base = values[0];
+        width = width_of(max_delta);
+      }
+    }
+  }
+
+  const size_t num_words = (values.size() * width + 63) / 64;
+  std::vector<uint64_t> words(num_words, 0);
+  if (width > 0){
+    for (size_t i = 0; i < values.size(); ++i){
+      const uint64_t v = mode == DELTA ? (i ? values[i] - values[i - 1] : 0) : values[i] - base;
+      const size_t bit = i * width, word = bit >> 6, offset = bit & 63;
+      words[word] |= v << offset;
+      if (offset + width > 64){
+        words[word + 1] |= v >> (64 - offset);
+      }
+    }
+  }
+
+  out.push_back(mode);
+  out.push_back(width);
+  out.insert(out.end(), reinterpret_cast<const char*>(&base), reinterpret_cast<const char*>(&base + 1));
+  out.insert(out.end(), reinterpret_cast<const char*>(words.data()),
+             reinterpret_cast<const char*>(words.data() + num_words));
+}
+
+// Sequential reader of a column written by pack_column().
+class ColumnReader {
+ public:
+  // Reads the column of `size` values at `in` and advances `in` past it.
+  ColumnReader(const char*& in, size_t size) {
+    mode_ = in[0];
+    width_ = in[1];
+    memcpy(&base_, in + 2, sizeof(uint64_t));
+    words_ = in + 2 + sizeof(uint64_t);
+    mask_ = width_ == 64 ? ~0ull : (1ull << width_) - 1;
+    in = words_ + (size * width_ + 63) / 64 * sizeof(uint64_t);
+  }
+
+  forceinline uint64_t Next() {
+    const size_t bit = pos_++ * width_;
+    uint64_t v;
+    if (width_ <= 57){
+      // One unaligned load covers the value.
+      v = (Load(bit >> 3) >> (bit & 7)) & mask_;
+    }
+    else{
+      const size_t offset = bit & 63;
+      v = Load((bit >> 6) * sizeof(uint64_t)) >> offset;
+      if (offset + width_ > 64){
+        v |= Load((bit >> 6) * sizeof(uint64_t) + sizeof(uint64_t)) << (64 - offset);
+      }
+      v &= mask_;
+    }
+    return mode_ ? (base_ += v) : base_ + v;
+  }
+
+ private:
+  forceinline uint64_t Load(size_t byte) const {
+    uint64_t w;
+    memcpy(&w, words_ + byte, sizeof(uint64_t));
+    return w;
+  }
+
+  uint8_t mode_, width_;
+  uint64_t base_, mask_;
+  const char* words_;
+  size_t pos_ = 0;
+};
+
+// Appends the chunk of operations ops[0, n) to `out`.
+template <class KeyType>
+static void encode_chunk(const Operation<KeyType>* ops, size_t n, std::vector<char>& out) {
+  std::vector<uint8_t> run_ops;
+  std::vector<uint32_t> run_lens;
+  std::vector<uint64_t> lo_keys, hi_keys, lookup_results, other_results;
+  lo_keys.reserve(n);
+  for (size_t i = 0; i < n; ++i){
+    if (i == 0 || ops[i].op != run_ops.back()){
+      run_ops.push_back(ops[i].op);
+      run_lens.push_back(0);
+    }
+    ++run_lens.back();
+    lo_keys.push_back(ops[i].lo_key);
+    if (ops[i].op == LOOKUP){
+      lookup_results.push_back(ops[i].result + 1);
+      continue;
+    }
+    if (ops[i].op == RANGE_QUERY){
+      hi_keys.push_back(ops[i].hi_key - ops[i].lo_key);
+    }
+    other_results.push_back(ops[i].result);
+  }
+
+  const uint32_t counts[2] = {uint32_t(n), uint32_t(run_ops.size())};
+  out.insert(out.end(), reinterpret_cast<const char*>(counts), reinterpret_cast<const char*>(counts + 2));
+  out.insert(out.end(), run_ops.begin(), run_ops.end());
+  out.insert(out.end(), reinterpret_cast<const char*>(run_lens.data()),
+             reinterpret_cast<const char*>(run_lens.data() + run_lens.size()));
+  pack_column(lo_keys, out);
+  pack_column(hi_keys, out);
+  pack_column(lookup_results, out);
+  pack_column(other_results, out);
+  out.resize((out.size() + 7) / 8 * 8, 0);
+}
+
+// Write the operations of `num_threads` threads as a columnar workload.
+// The format fields of `header` are filled in; the workload parameters
+// are taken as given.
+template <class KeyType>
+static void write_workload(std::vector<Operation<KeyType>> const* ops, uint64_t num_threads,
+                           WorkloadHeader header, const std::string& filename,
+                           const bool print = true) {
+  static_assert(std::is_integral<KeyType>::value, "columnar workloads need fixed-width keys");
+  memcpy(header.magic, kWorkloadMagic, sizeof(kWorkloadMagic));
+  header.version = kWorkloadVersion;
+  header.key_size = sizeof(KeyType);
+  header.num_threads = num_threads;
+  if (header.chunk_size == 0 || header.chunk_size > std::numeric_limits<uint32_t>::max()) {
+    fail("invalid chunk size");
+  }
+
+  size_t size = 0, bytes = 0;
+  const uint64_t ns = util::timing([&] {
+    std::ofstream out(filename, std::ios_base::trunc | std::ios::binary);
+    if (!out.is_open()) {
+      std::cerr << "unable to open " << filename << std::endl;
+      exit(EXIT_FAILURE);
+    }
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    bytes += sizeof(header);
+
+    std::vector<char> chunks;
+    for (size_t i = 0; i < num_threads; ++i){
+      const uint64_t num_ops = ops[i].size();
+      const uint64_t num_chunks = (num_ops + header.chunk_size - 1) / header.chunk_size;
+      std::vector<uint64_t> offsets;
+      offsets.reserve(num_chunks + 1);
+      chunks.clear();
+      for (size_t begin = 0; begin < num_ops; begin += header.chunk_size){
+        offsets.push_back(chunks.size());
+        encode_chunk(ops[i].data() + begin, std::min<size_t>(header.chunk_size, num_ops - begin), chunks);
+      }
+      offsets.push_back(chunks.size());
+
+      out.write(reinterpret_cast<const char*>(&num_ops), sizeof(uint64_t));
+      out.write(reinterpret_cast<const char*>(&num_chunks), sizeof(uint64_t));
+      out.write(reinterpret_cast<const char*>(offsets.data()), offsets.size() * sizeof(uint64_t));
+      out.write(chunks.data(), chunks.size());
+      size += num_ops;
+      bytes += 2 * sizeof(uint64_t) + offsets.size() * sizeof(uint64_t) + chunks.size();
+    }
+    const uint64_t trailer = 0;
+    out.write(reinterpret_cast<const char*>(&trailer), sizeof(uint64_t));
+    bytes += sizeof(uint64_t);
+    out.close();
+  });
+  const uint64_t ms = ns / 1e6;
+  if (print) {
+    std::cout << "wrote " << size << " values (" << bytes << " bytes, "
+              << static_cast<double>(bytes) / std::max<size_t>(size, 1) << " bytes/value) to "
+              << filename << " in " << ms << " ms (" << static_cast<double>(size) / 1000 / ms
+              << " M values/s)" << std::endl;
+  }
+}
+
+// Memory-mapped columnar workload, decoded one chunk at a time.
+template <class KeyType>
+class WorkloadFile {
+ public:
+  WorkloadFile(const std::string& filename, bool populate = true, bool huge_pages = false,
+               bool print = true) {
+    static_assert(std::is_integral<KeyType>::value, "columnar workloads need fixed-width keys");
+    size_t size = 0;
+    const uint64_t ns = util::timing([&] {
+      file_ = std::make_shared<const MappedFile>(filename, populate, huge_pages);
+      if (file_->size() < sizeof(WorkloadHeader)) {
+        fail("mapped file is truncated");
+      }
+      memcpy(&header_, file_->data(), sizeof(WorkloadHeader));
+      if (memcmp(header_.magic, kWorkloadMagic, sizeof(kWorkloadMagic)) != 0) {
+        fail(filename + " is not a columnar workload");
+      }
+      if (header_.version != kWorkloadVersion) {
+        fail(filename + " has unsupported workload version " + std::to_string(header_.version));
+      }
+      if (header_.key_size != sizeof(KeyType)) {
+        fail(filename + " has " + std::to_string(header_.key_size * 8) + "-bit keys");
+      }
+
+      size_t offset = sizeof(WorkloadHeader);
+      for (size_t i = 0; i < header_.num_threads; ++i){
+        Section section;
+        uint64_t counts[2];
+        if (offset + sizeof(counts) > file_->size()) {
+          fail("mapped file is truncated");
+        }
+        memcpy(counts, file_->data() + offset, sizeof(counts));
+        offset += sizeof(counts);
+        section.size = counts[0];
+        section.offsets.resize(counts[1] + 1);
+        if (offset + section.offsets.size() * sizeof(uint64_t) > file_->size()) {
+          fail("mapped file is truncated");
+        }
+        memcpy(section.offsets.data(), file_->data() + offset, section.offsets.size() * sizeof(uint64_t));
+        offset += section.offsets.size() * sizeof(uint64_t);
+        section.data = file_->data() + offset;
+        offset += section.offsets.back();
+        if (offset > file_->size()) {
+          fail("mapped file is truncated");
+        }
+        size += section.size;
+        sections_.push_back(std::move(section));
+      }
+      if (offset + sizeof(uint64_t) > file_->size()) {
+        fail("mapped file is truncated");
+      }
+    });
+    const uint64_t ms = ns / 1e6;
+
+    if (print) {
+      std::cout << "mapped " << size << " values (columnar, " << file_->size() << " bytes) from "
+                << filename << " in " << ms << " ms" << std::endl;
+    }
+  }
+
+  const WorkloadHeader& header() const { return header_; }
+  size_t num_threads() const { return sections_.size(); }
+  size_t chunk_size() const { return header_.chunk_size; }
+  // Number of operations of the thread.
+  size_t size(size_t thread) const { return sections_[thread].size; }
+
+  // Runs of equal op codes of the thread's operations, as (op code, length).
+  std::vector<std::pair<uint8_t, uint64_t>> Runs(size_t thread) const {
+    const Section& section = sections_[thread];
+    std::vector<std::pair<uint8_t, uint64_t>> runs;
+    for (size_t c = 0; c + 1 < section.offsets.size(); ++c){
+      const char* in = section.data + section.offsets[c];
+      uint32_t counts[2];
+      memcpy(counts, in, sizeof(counts));
+      const uint8_t* run_ops = reinterpret_cast<const uint8_t*>(in + sizeof(counts));
+      const char* run_lens = in + sizeof(counts) + counts[1];
+      for (size_t r = 0; r < counts[1]; ++r){
+        uint32_t len;
+        memcpy(&len, run_lens + r * sizeof(uint32_t), sizeof(uint32_t));
+        if (!runs.empty() && runs.back().first == run_ops[r]){
+          runs.back().second += len;
+        }
+        else{
+          runs.emplace_back(run_ops[r], len);
+        }
+      }
+    }
+    return runs;
+  }
+
+  // Decodes chunk `chunk` of the thread into `out`, and returns its number of operations.
+  size_t DecodeChunk(size_t thread, size_t chunk, Operation<KeyType>* out) const {
+    const char* in = sections_[thread].data + sections_[thread].offsets[chunk];
+    uint32_t counts[2];
+    memcpy(counts, in, sizeof(counts));
+    const size_t n = counts[0], num_runs = counts[1];
+    const uint8_t* run_ops = reinterpret_cast<const uint8_t*>(in + sizeof(counts));
+    const char* run_lens = in + sizeof(counts) + num_runs;
+    in = run_lens + num_runs * sizeof(uint32_t);
+
+    size_t num_range_queries = 0, num_lookups = 0;
+    for (size_t r = 0; r < num_runs; ++r){
+      uint32_t len;
+      memcpy(&len, run_lens + r * sizeof(uint32_t), sizeof(uint32_t));
+      num_range_queries += run_ops[r] == RANGE_QUERY ? len : 0;
+      num_lookups += run_ops[r] == LOOKUP ? len : 0;
+    }
+    ColumnReader lo_keys(in, n), hi_keys(in, num_range_queries),
+                 lookup_results(in, num_lookups), other_results(in, n - num_lookups);
+
+    // Decode column by column, so that every loop reads a single column.
+    for (size_t i = 0; i < n; ++i){
+      out[i].lo_key = lo_keys.Next();
+    }
+    size_t i = 0;
+    for (size_t r = 0; r < num_runs; ++r){
+      uint32_t len;
+      memcpy(&len, run_lens + r * sizeof(uint32_t), sizeof(uint32_t));
+      const uint8_t op = run_ops[r];
+      const size_t end = i + len;
+      if (op == LOOKUP){
+        for (; i < end; ++i){
+          out[i].op = op;
+          out[i].hi_key = 0;
+          out[i].result = lookup_results.Next() - 1;
+        }
+      }
+      else if (op == RANGE_QUERY){
+        for (; i < end; ++i){
+          out[i].op = op;
+          out[i].hi_key = out[i].lo_key + hi_keys.Next();
+          out[i].result = other_results.Next();
+        }
+      }
+      else{
+        for (; i < end; ++i){
+          out[i].op = op;
+          out[i].hi_key = 0;
+          out[i].result = other_results.Next();
+        }
+      }
+    }
+    return n;
+  }
+
+ private:
+  struct Section {
+    uint64_t size;
+    // Chunk offsets relative to `data`, plus the end of the last chunk.
+    std::vector<uint64_t> offsets;
+    const char* data;
+  };
+
+  std::shared_ptr<const MappedFile> file_;
+  WorkloadHeader header_;
+  std::vector<Section> sections_;
+};
+
+// Streams the operations of one thread of a columnar workload in chunks.
+// A decoder thread decodes the next chunk into the second of two buffers
+// while the current chunk executes, so that only two chunks of decoded
+// operations are live at any time.
+template <class KeyType>
+class WorkloadStream {
+ public:
+  WorkloadStream(std::shared_ptr<const WorkloadFile<KeyType>> file, size_t thread)
+      : file_(std::move(file)), thread_(thread), chunk_size_(file_->chunk_size()) {
+    for (auto& buffer: buffers_) {
+      buffer.resize(chunk_size_);
+    }
+    decoder_ = std::thread([this]() { DecodeLoop(); });
+  }
+
+  WorkloadStream(const WorkloadStream&) = delete;
+  WorkloadStream& operator=(const WorkloadStream&) = delete;
+
+  ~WorkloadStream() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      shutdown_ = true;
+    }
+    work_cv_.notify_one();
+    decoder_.join();
+  }
+
+  // Restarts the stream at operation `start`, ending before `limit`,
+  // and starts decoding the first chunks.
+  void Seek(size_t start, size_t limit) {
+    pos_ = start;
+    limit_ = limit;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      ++generation_;
+      next_ = start / chunk_size_;
+      end_ = start < limit ? (limit + chunk_size_ - 1) / chunk_size_ : next_;
+      allowed_ = next_ + 2;
+      ready_[0] = ready_[1] = NONE;
+    }
+    work_cv_.notify_one();
+  }
+
+  // Returns the next decoded operations and sets `n` to their number,
+  // or returns nullptr once `limit` is reached. The previously returned
+  // operations are released.
+  const Operation<KeyType>* Next(size_t& n) {
+    if (pos_ >= limit_) return nullptr;
+    const size_t chunk = pos_ / chunk_size_;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      allowed_ = chunk + 2;
+      work_cv_.notify_one();
+      ready_cv_.wait(lock, [&]() { return ready_[chunk & 1] == chunk; });
+    }
+    const size_t first = chunk * chunk_size_;
+    n = std::min(limit_, first + chunk_size_) - pos_;
+    const Operation<KeyType>* ops = buffers_[chunk & 1].data() + (pos_ - first);
+    pos_ += n;
+    return ops;
+  }
+
+ private:
+  static constexpr size_t NONE = std::numeric_limits<size_t>::max();
+
+  void DecodeLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      work_cv_.wait(lock, [&]() { return shutdown_ || (next_ < end_ && next_ < allowed_); });
+      if (shutdown_) return;
+      const size_t chunk = next_;
+      const uint64_t generation = generation_;
+      lock.unlock();
+      file_->DecodeChunk(thread_, chunk, buffers_[chunk & 1].data());
+      lock.lock();
+      // Drop chunks decoded for a stream that was restarted meanwhile.
+      if (generation == generation_) {
+        ready_[chunk & 1] = chunk;
+        ++next_;
+        ready_cv_.notify_one();
+      }
+    }
+  }
+
+  const std::shared_ptr<const WorkloadFile<KeyType>> file_;
+  const size_t thread_, chunk_size_;
+  std::vector<Operation<KeyType>> buffers_[2];
+  // Consumer position.
+  size_t pos_ = 0, limit_ = 0;
+
+  std::mutex mutex_;
+  std::condition_variable work_cv_, ready_cv_;
+  uint64_t generation_ = 0;
+  // Next chunk to decode, end of the chunks to decode, and the first chunk
+  // that may not be decoded yet because its buffer is still in use.
+  size_t next_ = 0, end_ = 0, allowed_ = 0;
+  // Chunk held by each buffer.
+  size_t ready_[2] = {NONE, NONE};
+  bool shutdown_ = false;
+  std::thread decoder_;
+};
+
+}  // namespace util